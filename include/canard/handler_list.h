@@ -31,9 +31,27 @@
 #define CANARD_NUM_HANDLERS 3
 #endif
 
+/// Number of hash buckets for message handlers per handler list, must be a power of two
+#ifndef CANARD_HANDLER_LIST_MESSAGE_BUCKETS
+#define CANARD_HANDLER_LIST_MESSAGE_BUCKETS 64
+#endif
+
+/// Number of slots for request and for response handlers per handler list, must be a power of two.
+/// With the default of 256 every service ID has a slot of its own.
+#ifndef CANARD_HANDLER_LIST_SERVICE_BUCKETS
+#define CANARD_HANDLER_LIST_SERVICE_BUCKETS 256
+#endif
+
+static_assert((CANARD_HANDLER_LIST_MESSAGE_BUCKETS & (CANARD_HANDLER_LIST_MESSAGE_BUCKETS - 1)) == 0,
+              "CANARD_HANDLER_LIST_MESSAGE_BUCKETS must be a power of two");
+static_assert((CANARD_HANDLER_LIST_SERVICE_BUCKETS & (CANARD_HANDLER_LIST_SERVICE_BUCKETS - 1)) == 0,
+              "CANARD_HANDLER_LIST_SERVICE_BUCKETS must be a power of two");
+
 namespace Canard {
  
 /// @brief HandlerList to register all handled message types.
+/// Handlers are indexed by transfer type and ID: messages in a hash table, requests and responses in tables
+/// indexed by service ID. Handlers sharing a slot are chained, most recently registered first.
 class HandlerList {
 public:
     /// @brief HandlerList Constructor
@@ -49,54 +67,67 @@ public:
 #ifdef WITH_SEMAPHORE
         WITH_SEMAPHORE(sem[index]);
 #endif
-        next = head[index];
-        head[index] = this;
         msgid = _msgid;
         signature = _signature;
         transfer_type = _transfer_type;
+        HandlerList*& slot = bucket(index, transfer_type, msgid);
+        next = slot;
+        slot = this;
+        generation[index]++;
     }
 
     /// @brief delete copy constructor and assignment operator
     HandlerList(const HandlerList&) = delete;
 
-    // destructor, remove the entry from the singly-linked list
+    // destructor, remove the entry from its bucket chain
     virtual ~HandlerList() NOINLINE_FUNC {
+        if (index >= CANARD_NUM_HANDLERS) {
+            return;
+        }
 #ifdef WITH_SEMAPHORE
         WITH_SEMAPHORE(sem[index]);
 #endif
-        HandlerList* entry = head[index];
-        if (entry == this) {
-            head[index] = next;
-            return;
-        }
-        while (entry != nullptr) {
-            if (entry->next == this) {
-                entry->next = next;
+        for (HandlerList** link = &bucket(index, transfer_type, msgid); *link != nullptr; link = &(*link)->next) {
+            if (*link == this) {
+                *link = next;
+                generation[index]++;
                 return;
             }
-            entry = entry->next;
         }
     }
 
-    /// @brief accept a message if it is handled by this handler list
+    /// @brief accept a transfer if it is handled by this handler list
     /// @param index Index of the handler list
+    /// @param transfer_type Type of the transfer, tells requests, responses and broadcasts apart
     /// @param msgid ID of the message/service
     /// @param[out] signature Signature of the message/service
-    /// @return true if the message is handled by this handler list
-    static bool accept_message(uint8_t index, uint16_t msgid, uint64_t &signature) NOINLINE_FUNC
+    /// @return true if the transfer is handled by this handler list
+    static bool accept_message(uint8_t index, CanardTransferType transfer_type, uint16_t msgid, uint64_t &signature) NOINLINE_FUNC
     {
+        if (index >= CANARD_NUM_HANDLERS) {
+            return false;
+        }
 #ifdef WITH_SEMAPHORE
         WITH_SEMAPHORE(sem[index]);
 #endif
-        HandlerList* entry = head[index];
-        while (entry != nullptr) {
-            if (entry->msgid == msgid) {
-                signature = entry->signature;
-                return true;
-            }
-            entry = entry->next;
+        const HandlerList* entry = find(index, transfer_type, msgid);
+        if (entry == nullptr) {
+            return false;
         }
-        return false;
+        signature = entry->signature;
+        return true;
+    }
+
+    /// @brief accept a message or service of any transfer type with the given ID
+    /// @param index Index of the handler list
+    /// @param msgid ID of the message/service
+    /// @param[out] signature Signature of the message/service
+    /// @return true if the message is handled by this handler list
+    static bool accept_message(uint8_t index, uint16_t msgid, uint64_t &signature) NOINLINE_FUNC
+    {
+        return accept_message(index, CanardTransferTypeBroadcast, msgid, signature) ||
+               accept_message(index, CanardTransferTypeRequest, msgid, signature) ||
+               accept_message(index, CanardTransferTypeResponse, msgid, signature);
     }
 
     /// @brief handle a message if it is handled by this handler list
@@ -104,17 +135,56 @@ public:
     /// @param transfer transfer object of the request
     static void handle_message(uint8_t index, const CanardRxTransfer& transfer) NOINLINE_FUNC
     {
+        if (index >= CANARD_NUM_HANDLERS) {
+            return;
+        }
 #ifdef WITH_SEMAPHORE
         WITH_SEMAPHORE(sem[index]);
 #endif
-        HandlerList* entry = head[index];
-        while (entry != nullptr) {
-            if (transfer.data_type_id == entry->msgid &&
-                entry->transfer_type == transfer.transfer_type) {
-                entry->handle_message(transfer);
-                return;
+        HandlerList* entry = find(index, CanardTransferType(transfer.transfer_type), transfer.data_type_id);
+        if (entry != nullptr) {
+            entry->handle_message(transfer);
+        }
+    }
+
+    /// @brief get the generation of a handler list
+    /// The generation changes whenever a handler is registered or removed.
+    /// @param index Index of the handler list
+    /// @return generation counter
+    static uint32_t get_generation(uint8_t index)
+    {
+        if (index >= CANARD_NUM_HANDLERS) {
+            return 0;
+        }
+        return generation[index];
+    }
+
+    /// @brief call a visitor for every registered handler
+    /// @param index Index of the handler list
+    /// @param visitor callable taking (CanardTransferType transfer_type, uint16_t msgid)
+    template <typename Visitor>
+    static void for_each_handler(uint8_t index, Visitor visitor)
+    {
+        if (index >= CANARD_NUM_HANDLERS) {
+            return;
+        }
+#ifdef WITH_SEMAPHORE
+        WITH_SEMAPHORE(sem[index]);
+#endif
+        for (const HandlerList* entry : message_table[index]) {
+            for (; entry != nullptr; entry = entry->next) {
+                visitor(entry->transfer_type, entry->msgid);
+            }
+        }
+        for (const HandlerList* entry : request_table[index]) {
+            for (; entry != nullptr; entry = entry->next) {
+                visitor(entry->transfer_type, entry->msgid);
+            }
+        }
+        for (const HandlerList* entry : response_table[index]) {
+            for (; entry != nullptr; entry = entry->next) {
+                visitor(entry->transfer_type, entry->msgid);
             }
-            entry = entry->next;
         }
     }
 
@@ -127,7 +197,33 @@ protected:
     HandlerList* next;
 
 private:
-    static HandlerList* head[CANARD_NUM_HANDLERS];
+    /// @brief get the head of the bucket chain a handler belongs to
+    static HandlerList*& bucket(uint8_t index, CanardTransferType transfer_type, uint16_t msgid)
+    {
+        switch (transfer_type) {
+        case CanardTransferTypeRequest:
+            return request_table[index][msgid & (CANARD_HANDLER_LIST_SERVICE_BUCKETS - 1)];
+        case CanardTransferTypeResponse:
+            return response_table[index][msgid & (CANARD_HANDLER_LIST_SERVICE_BUCKETS - 1)];
+        default:
+            return message_table[index][msgid & (CANARD_HANDLER_LIST_MESSAGE_BUCKETS - 1)];
+        }
+    }
+
+    /// @brief find the most recently registered handler for a transfer
+    static HandlerList* find(uint8_t index, CanardTransferType transfer_type, uint16_t msgid)
+    {
+        HandlerList* entry = bucket(index, transfer_type, msgid);
+        while (entry != nullptr && (entry->msgid != msgid || entry->transfer_type != transfer_type)) {
+            entry = entry->next;
+        }
+        return entry;
+    }
+
+    static HandlerList* message_table[CANARD_NUM_HANDLERS][CANARD_HANDLER_LIST_MESSAGE_BUCKETS];
+    static HandlerList* request_table[CANARD_NUM_HANDLERS][CANARD_HANDLER_LIST_SERVICE_BUCKETS];
+    static HandlerList* response_table[CANARD_NUM_HANDLERS][CANARD_HANDLER_LIST_SERVICE_BUCKETS];
+    static uint32_t generation[CANARD_NUM_HANDLERS];
 #ifdef WITH_SEMAPHORE
     static Canard::Semaphore sem[CANARD_NUM_HANDLERS];
 #endif
@@ -138,5 +234,9 @@ private:
 
 } // namespace Canard
 
-#define DEFINE_HANDLER_LIST_HEADS() Canard::HandlerList* Canard::HandlerList::head[CANARD_NUM_HANDLERS] = {}
+#define DEFINE_HANDLER_LIST_HEADS() \
+    Canard::HandlerList* Canard::HandlerList::message_table[CANARD_NUM_HANDLERS][CANARD_HANDLER_LIST_MESSAGE_BUCKETS] = {}; \
+    Canard::HandlerList* Canard::HandlerList::request_table[CANARD_NUM_HANDLERS][CANARD_HANDLER_LIST_SERVICE_BUCKETS] = {}; \
+    Canard::HandlerList* Canard::HandlerList::response_table[CANARD_NUM_HANDLERS][CANARD_HANDLER_LIST_SERVICE_BUCKETS] = {}; \
+    uint32_t Canard::HandlerList::generation[CANARD_NUM_HANDLERS] = {}
 #define DEFINE_HANDLER_LIST_SEMAPHORES() Canard::Semaphore Canard::HandlerList::sem[CANARD_NUM_HANDLERS] = {}
@@ -94,6 +94,15 @@ public:
 
 protected:
     /// @brief forward accept_message call to indexed HandlerList
+    /// @param transfer_type type of the transfer
+    /// @param msgid ID of the message/service
+    /// @param[out] signature signature of message/service
+    /// @return true if the message/service is accepted
+    inline bool accept_message(CanardTransferType transfer_type, uint16_t msgid, uint64_t &signature) {
+        return HandlerList::accept_message(index, transfer_type, msgid, signature);
+    }
+
+    /// @brief forward accept_message call to indexed HandlerList, matching any transfer type
     /// @param msgid ID of the message/service
     /// @param[out] signature signature of message/service
     /// @return true if the message/service is accepted
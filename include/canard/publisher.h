@@ -56,16 +56,27 @@ protected:
     /// @brief Send a message
     /// @param Transfer message to send
     /// @return true if the message was put into the queue successfully
+    /// If transfer.inout_transfer_id is set, it is used as is, otherwise the transfer ID slot is resolved here.
     bool send(Transfer& transfer, uint8_t destination_node_id = CANARD_BROADCAST_NODE_ID) NOINLINE_FUNC {
         switch (transfer.transfer_type)
         {
         case CanardTransferTypeBroadcast:
-            transfer.inout_transfer_id = TransferObject::get_tid_ptr(interface.get_index(),transfer.data_type_id, CanardTransferTypeBroadcast, interface.get_node_id(), destination_node_id);
+            if (transfer.inout_transfer_id == nullptr) {
+                transfer.inout_transfer_id = get_broadcast_tid_ptr(transfer.data_type_id);
+            }
+            if (transfer.inout_transfer_id == nullptr) {
+                return false;
+            }
             transfer.priority = priority;
             transfer.timeout_ms = timeout;
             return interface.broadcast(transfer);
         case CanardTransferTypeRequest:
-            transfer.inout_transfer_id = TransferObject::get_tid_ptr(interface.get_index(),transfer.data_type_id, CanardTransferTypeRequest, interface.get_node_id(), destination_node_id);
+            if (transfer.inout_transfer_id == nullptr) {
+                transfer.inout_transfer_id = TransferObject::get_tid_ptr(interface.get_index(),transfer.data_type_id, CanardTransferTypeRequest, interface.get_node_id(), destination_node_id);
+            }
+            if (transfer.inout_transfer_id == nullptr) {
+                return false;
+            }
             transfer.priority = priority;
             transfer.timeout_ms = timeout;
             return interface.request(destination_node_id, transfer);
@@ -75,8 +86,30 @@ protected:
         }
     }
 private:
+    /// @brief get the broadcast transfer ID slot, resolved once and cached
+    /// The slot is resolved again if the node ID, the data type or the slot generation changes.
+    uint8_t* get_broadcast_tid_ptr(uint16_t data_type_id) {
+        const uint8_t node_id = interface.get_node_id();
+        const uint32_t generation = TransferObject::get_generation(interface.get_index());
+        if (broadcast_tid == nullptr ||
+            broadcast_tid_node_id != node_id ||
+            broadcast_tid_data_type_id != data_type_id ||
+            broadcast_tid_generation != generation) {
+            broadcast_tid = TransferObject::get_tid_ptr(interface.get_index(), data_type_id, CanardTransferTypeBroadcast, node_id, CANARD_BROADCAST_NODE_ID);
+            broadcast_tid_node_id = node_id;
+            broadcast_tid_data_type_id = data_type_id;
+            broadcast_tid_generation = generation;
+        }
+        return broadcast_tid;
+    }
+
     uint8_t priority = CANARD_TRANSFER_PRIORITY_MEDIUM; ///< Priority of the message
     uint32_t timeout = 1000; ///< Timeout of the message in ms
+
+    uint8_t* broadcast_tid = nullptr; ///< Cached broadcast transfer ID slot
+    uint32_t broadcast_tid_generation = 0; ///< Slot generation the cached slot belongs to
+    uint16_t broadcast_tid_data_type_id = 0; ///< Data type the cached slot belongs to
+    uint8_t broadcast_tid_node_id = CANARD_BROADCAST_NODE_ID; ///< Node ID the cached slot belongs to
 };
 
 template <typename msgtype>
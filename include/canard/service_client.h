@@ -125,12 +125,35 @@ public:
 #if CANARD_MULTI_IFACE
         req_transfer.iface_mask = CANARD_IFACE_ALL;
 #endif
-        transfer_id = *TransferObject::get_tid_ptr(interface.get_index(), rsptype::cxx_iface::ID, CanardTransferTypeRequest, interface.get_node_id(), destination_node_id);
+        req_transfer.inout_transfer_id = get_request_tid_ptr(destination_node_id);
+        if (req_transfer.inout_transfer_id == nullptr) {
+            return false;
+        }
+        transfer_id = *req_transfer.inout_transfer_id;
         server_node_id = destination_node_id;
         return send(req_transfer, destination_node_id);
     }
 
 private:
+    /// @brief get the request transfer ID slot for a server, cached per destination node ID
+    uint8_t* get_request_tid_ptr(uint8_t destination_node_id) {
+        const uint8_t node_id = interface.get_node_id();
+        if (destination_node_id > CANARD_MAX_NODE_ID) {
+            return TransferObject::get_tid_ptr(interface.get_index(), rsptype::cxx_iface::ID, CanardTransferTypeRequest, node_id, destination_node_id);
+        }
+        const uint32_t generation = TransferObject::get_generation(interface.get_index());
+        if (request_tid_node_id != node_id || request_tid_generation != generation) {
+            memset(request_tids, 0, sizeof(request_tids));
+            request_tid_node_id = node_id;
+            request_tid_generation = generation;
+        }
+        uint8_t*& tid = request_tids[destination_node_id];
+        if (tid == nullptr) {
+            tid = TransferObject::get_tid_ptr(interface.get_index(), rsptype::cxx_iface::ID, CanardTransferTypeRequest, node_id, destination_node_id);
+        }
+        return tid;
+    }
+
     static Client<rsptype>* branch_head[CANARD_NUM_HANDLERS];
     Client<rsptype>* next;
     uint8_t server_node_id;
@@ -138,6 +161,10 @@ private:
     uint8_t req_buf[rsptype::cxx_iface::REQ_MAX_SIZE];
     Callback<rsptype> &cb;
     uint8_t transfer_id;
+
+    uint8_t* request_tids[CANARD_MAX_NODE_ID + 1] {}; ///< Cached request transfer ID slots, indexed by server node ID
+    uint32_t request_tid_generation = 0; ///< Slot generation the cached slots belong to
+    uint8_t request_tid_node_id = CANARD_BROADCAST_NODE_ID; ///< Node ID the cached slots belong to
 };
 
 template <typename rsptype>
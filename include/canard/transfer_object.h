@@ -26,6 +26,12 @@
 #include <canard.h>
 #include "helpers.h"
 
+/// Number of transfer ID slots preallocated per handler list index. If zero, slots are allocated with
+/// CANARD_MALLOC on first use of a transfer descriptor.
+#ifndef CANARD_TRANSFER_OBJECT_POOL_SIZE
+#define CANARD_TRANSFER_OBJECT_POOL_SIZE 0
+#endif
+
 namespace Canard {
 
 #define MAKE_TRANSFER_DESCRIPTOR(data_type_id, transfer_type, src_node_id, dst_node_id)             \
@@ -35,7 +41,18 @@ namespace Canard {
 /// @brief list of object to retain transfer id for transfer descriptor
 class TransferObject {
 public:
-    TransferObject(uint32_t _transfer_desc) : next(nullptr), transfer_desc(_transfer_desc), tid(0) {}
+    TransferObject(uint32_t _transfer_desc = 0) : next(nullptr), transfer_desc(_transfer_desc), tid(0) {}
+
+    /// @brief get the generation of the slots of a handler list index
+    /// The generation changes whenever slots are released, pointers cached by senders must then be resolved again.
+    /// @param index Index of the handler list
+    /// @return generation counter
+    static uint32_t get_generation(uint8_t index) {
+        if (index >= CANARD_NUM_HANDLERS) {
+            return 0;
+        }
+        return generation[index];
+    }
 
     static uint8_t* get_tid_ptr(uint8_t index, uint16_t data_type_id, CanardTransferType transfer_type, uint8_t src_node_id, uint8_t dst_node_id) NOINLINE_FUNC {
         if (index >= CANARD_NUM_HANDLERS) {
@@ -47,7 +64,7 @@ public:
         uint32_t _transfer_desc = MAKE_TRANSFER_DESCRIPTOR(data_type_id, transfer_type, src_node_id, dst_node_id);
         // check head
         if (tid_map_head[index] == nullptr) {
-            tid_map_head[index] = allocate<TransferObject>(_transfer_desc);
+            tid_map_head[index] = create(index, _transfer_desc);
             if (tid_map_head[index]  == nullptr) {
                 return nullptr;
             }
@@ -66,7 +83,7 @@ public:
         }
 
         // create a new entry, if not found
-        tid_map_ptr->next = allocate<TransferObject>(_transfer_desc);
+        tid_map_ptr->next = create(index, _transfer_desc);
         if (tid_map_ptr->next == nullptr) {
             return nullptr;
         }
@@ -80,16 +97,39 @@ public:
 #ifdef WITH_SEMAPHORE
         WITH_SEMAPHORE(sem[index]);
 #endif
+#if CANARD_TRANSFER_OBJECT_POOL_SIZE
+        pool_used[index] = 0;
+#else
         TransferObject *tid_map_ptr = tid_map_head[index];
         while(tid_map_ptr) {
             TransferObject *next = tid_map_ptr->next;
             deallocate(tid_map_ptr);
             tid_map_ptr = next;
         }
+#endif
         tid_map_head[index] = nullptr;
+        generation[index]++;
     }
 private:
+    /// @brief get a new slot, from the static pool if configured
+    static TransferObject* create(uint8_t index, uint32_t _transfer_desc) {
+#if CANARD_TRANSFER_OBJECT_POOL_SIZE
+        if (pool_used[index] >= CANARD_TRANSFER_OBJECT_POOL_SIZE) {
+            return nullptr;
+        }
+        return new (&pool[index][pool_used[index]++]) TransferObject(_transfer_desc);
+#else
+        (void)index;
+        return allocate<TransferObject>(_transfer_desc);
+#endif
+    }
+
     static TransferObject *tid_map_head[CANARD_NUM_HANDLERS];
+    static uint32_t generation[CANARD_NUM_HANDLERS];
+#if CANARD_TRANSFER_OBJECT_POOL_SIZE
+    static TransferObject pool[CANARD_NUM_HANDLERS][CANARD_TRANSFER_OBJECT_POOL_SIZE];
+    static uint16_t pool_used[CANARD_NUM_HANDLERS];
+#endif
 #ifdef WITH_SEMAPHORE
     static Canard::Semaphore sem[CANARD_NUM_HANDLERS];
 #endif
@@ -100,6 +140,17 @@ private:
 
 } // namespace Canard
 
-#define DEFINE_TRANSFER_OBJECT_HEADS() Canard::TransferObject* Canard::TransferObject::tid_map_head[CANARD_NUM_HANDLERS] = {nullptr}
+#if CANARD_TRANSFER_OBJECT_POOL_SIZE
+#define DEFINE_TRANSFER_OBJECT_POOL() \
+    Canard::TransferObject Canard::TransferObject::pool[CANARD_NUM_HANDLERS][CANARD_TRANSFER_OBJECT_POOL_SIZE]; \
+    uint16_t Canard::TransferObject::pool_used[CANARD_NUM_HANDLERS] = {}
+#else
+#define DEFINE_TRANSFER_OBJECT_POOL() static_assert(true, "")
+#endif
+
+#define DEFINE_TRANSFER_OBJECT_HEADS() \
+    Canard::TransferObject* Canard::TransferObject::tid_map_head[CANARD_NUM_HANDLERS] = {nullptr}; \
+    uint32_t Canard::TransferObject::generation[CANARD_NUM_HANDLERS] = {}; \
+    DEFINE_TRANSFER_OBJECT_POOL()
 
 #define DEFINE_TRANSFER_OBJECT_SEMAPHORES() Canard::Semaphore Canard::TransferObject::sem[CANARD_NUM_HANDLERS];
@@ -1,40 +1,196 @@
 #include "canard_interface.hpp"
 
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+
 DEFINE_HANDLER_LIST_HEADS();
 DEFINE_TRANSFER_OBJECT_HEADS();
 
-void CanardInterface::init(const char *interface_name)
+void CanardInterface::init(const char *interface_name, bool canfd)
 {
-    int16_t result = socketcanInit(&socketcan_, interface_name);
-    if(result < 0)
+    init(&interface_name, 1, canfd);
+}
+
+void CanardInterface::init(const char *const *interface_names, uint8_t num_ifaces, bool canfd)
+{
+    if(num_ifaces == 0 || num_ifaces > CANARD_INTERFACE_MAX_IFACES)
+    {
+        std::cerr << "Unsupported number of CAN interfaces " << int(num_ifaces)
+                  << ", at most " << CANARD_INTERFACE_MAX_IFACES << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+#if !CANARD_ENABLE_CANFD
+    if(canfd)
     {
-        std::cerr << "Failed to initialize the socketcan interface" << std::endl;
+        std::cerr << "CAN FD requires a build with CANARD_ENABLE_CANFD" << std::endl;
         exit(EXIT_FAILURE);
     }
+#endif
+    // Publishers and clients send CAN FD by default on a CAN FD interface
+    set_canfd(canfd);
+
+    for(uint8_t i = 0; i < num_ifaces; i++)
+    {
+        SocketCANInstance &socketcan = ifaces_[i].socketcan;
+#if CANARD_ENABLE_CANFD
+        int16_t result = socketcanInit(&socketcan, interface_names[i], canfd);
+#else
+        int16_t result = socketcanInit(&socketcan, interface_names[i]);
+#endif
+        if(result < 0)
+        {
+            std::cerr << "Failed to initialize the socketcan interface " << interface_names[i] << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        // Received frames carry the index of their bus, the library uses it to discard redundant copies
+        socketcan.iface_id = i;
+
+        // Kernel timestamps give the real arrival time of every frame, not the time the receive call returned
+        if(socketcanSetTimestampMode(&socketcan, SocketCANTimestampSoftware) < 0)
+        {
+            std::cerr << "Kernel RX timestamps are not available, errno '" << strerror(errno) << "'" << std::endl;
+        }
+    }
+    num_ifaces_ = num_ifaces;
+
+    releasePools();
+    mapPool(rx_pool_, size_t(pool_config_.rx_blocks) * CANARD_RX_BLOCK_SIZE);
+    mapPool(tx_pool_, size_t(pool_config_.tx_blocks) * CANARD_MEM_BLOCK_SIZE);
 
     // Initialize canard object
     canardInit( &canard_, 
-                memory_pool_, 
-                sizeof(memory_pool_), 
+                rx_pool_.base, 
+                size_t(pool_config_.rx_blocks) * CANARD_RX_BLOCK_SIZE, 
                 onTransferReceived, 
                 shouldAcceptTransfer, 
                 this);
 
+    // Queued TX frames get their own pool, a congested bus then cannot take the memory needed for reception
+    canardSetTxArena(&canard_, tx_pool_.base, size_t(pool_config_.tx_blocks) * CANARD_MEM_BLOCK_SIZE);
+
+    // Deliver multi-frame transfers contiguously so the decoders never walk the block chain
+    canardSetRxReassemblyBuffer(&canard_, rx_reassembly_buffer_, sizeof(rx_reassembly_buffer_));
+
+    // Start the time base before any frame is timestamped
+    (void)micros64_epoch();
+
     // Set the node id
     canardSetLocalNodeID(&canard_, 127);
 }
 
+// Default huge page size in bytes as reported by the kernel, 0 if unknown
+static size_t hugePageSize()
+{
+    FILE *meminfo = fopen("/proc/meminfo", "r");
+    if(meminfo == nullptr)
+    {
+        return 0;
+    }
+
+    size_t size_kib = 0;
+    char line[128];
+    while(fgets(line, sizeof(line), meminfo) != nullptr)
+    {
+        if(sscanf(line, "Hugepagesize: %zu kB", &size_kib) == 1)
+        {
+            break;
+        }
+    }
+    fclose(meminfo);
+    return size_kib * 1024;
+}
+
+void CanardInterface::mapPool(Pool &pool, size_t size)
+{
+    if(size == 0)
+    {
+        return;
+    }
+
+    // mmap() returns page aligned memory, so the blocks never straddle cache lines more than their size requires.
+    // MAP_POPULATE takes all page faults now instead of on the first transfers.
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE;
+    void *base = MAP_FAILED;
+    size_t mapped_size = size;
+
+    if(pool_config_.hugepages)
+    {
+        // Huge page mappings have to be unmapped in whole huge pages
+        const size_t huge_page = hugePageSize();
+        if(huge_page > 0)
+        {
+            mapped_size = (size + huge_page - 1) / huge_page * huge_page;
+            base = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+        }
+        if(base == MAP_FAILED)
+        {
+            std::cerr << "Huge pages are not available for the memory pool, errno '" << strerror(errno)
+                      << "', using normal pages" << std::endl;
+            mapped_size = size;
+        }
+    }
+
+    if(base == MAP_FAILED)
+    {
+        base = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if(base == MAP_FAILED)
+        {
+            std::cerr << "Failed to map a memory pool of " << size << " bytes, errno '" << strerror(errno) << "'"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if(pool_config_.hugepages)
+        {
+            // Transparent huge pages still cut the TLB misses of a large pool where the kernel can provide them
+            (void)madvise(base, mapped_size, MADV_HUGEPAGE);
+        }
+    }
+
+    pool.base = base;
+    pool.size = mapped_size;
+}
+
+void CanardInterface::releasePools()
+{
+    for(Pool *pool : {&rx_pool_, &tx_pool_})
+    {
+        if(pool->base != nullptr)
+        {
+            munmap(pool->base, pool->size);
+            pool->base = nullptr;
+            pool->size = 0;
+        }
+    }
+}
+
+void CanardInterface::setTxTransfer(const Canard::Transfer &transfer)
+{
+    // Fields without a counterpart in Canard::Transfer, e.g. the TAO flag of CAN FD builds, keep their defaults
+    canardInitTxTransfer(&tx_transfer_);
+    tx_transfer_.transfer_type = transfer.transfer_type;
+    tx_transfer_.data_type_signature = transfer.data_type_signature;
+    tx_transfer_.data_type_id = transfer.data_type_id;
+    tx_transfer_.inout_transfer_id = transfer.inout_transfer_id;
+    tx_transfer_.priority = transfer.priority;
+    tx_transfer_.payload = (const uint8_t *)transfer.payload;
+    tx_transfer_.payload_len = uint16_t(transfer.payload_len);
+#if CANARD_ENABLE_CANFD
+    tx_transfer_.canfd = transfer.canfd;
+#endif
+#if CANARD_MULTI_IFACE
+    tx_transfer_.iface_mask = uint8_t(transfer.iface_mask & ((1U << num_ifaces_) - 1U));
+#endif
+}
+
 bool CanardInterface::broadcast(const Canard::Transfer &transfer)
 {
-    tx_transfer_ = {
-        .transfer_type = transfer.transfer_type,
-        .data_type_signature = transfer.data_type_signature,
-        .data_type_id = transfer.data_type_id,
-        .inout_transfer_id = transfer.inout_transfer_id,
-        .priority = transfer.priority,
-        .payload = (const uint8_t *)transfer.payload,
-        .payload_len = uint16_t(transfer.payload_len),
-    };
+    setTxTransfer(transfer);
 
     return canardBroadcastObj(&canard_, &tx_transfer_) > 0;
 }
@@ -42,58 +198,646 @@ bool CanardInterface::broadcast(const Canard::Transfer &transfer)
 bool CanardInterface::request(uint8_t dest_node_id, 
 const Canard::Transfer &transfer)
 {
-    tx_transfer_ = {
-        .transfer_type = transfer.transfer_type,
-        .data_type_signature = transfer.data_type_signature,
-        .data_type_id = transfer.data_type_id,
-        .inout_transfer_id = transfer.inout_transfer_id,
-        .priority = transfer.priority,
-        .payload = (const uint8_t *)transfer.payload,
-        .payload_len = uint16_t(transfer.payload_len),
-    };
+    setTxTransfer(transfer);
 
     return canardRequestOrRespondObj(&canard_, dest_node_id, &tx_transfer_) > 0; 
 }
 
 bool CanardInterface::respond(uint8_t dest_node_id, const Canard::Transfer &transfer)
 {
-    tx_transfer_ = {
-        .transfer_type = transfer.transfer_type,
-        .data_type_signature = transfer.data_type_signature,
-        .data_type_id = transfer.data_type_id,
-        .inout_transfer_id = transfer.inout_transfer_id,
-        .priority = transfer.priority,
-        .payload = (const uint8_t *)transfer.payload,
-        .payload_len = uint16_t(transfer.payload_len),
-    };
+    setTxTransfer(transfer);
     return canardRequestOrRespondObj(&canard_, dest_node_id, &tx_transfer_) > 0;
 }
 
+uint16_t CanardInterface::peekTxFrames(uint8_t iface, const CanardCANFrame** frames, uint16_t max_frames) const
+{
+#if CANARD_MULTI_IFACE
+    return canardPeekTxQueueFramesForIface(&canard_, iface, frames, max_frames);
+#else
+    (void)iface;
+    return canardPeekTxQueueFrames(&canard_, frames, max_frames);
+#endif
+}
+
+void CanardInterface::popTxFrames(uint8_t iface, uint16_t frame_count, CanardTxFrameOutcome outcome)
+{
+#if CANARD_MULTI_IFACE
+    canardRemoveTxQueueFramesForIface(&canard_, iface, frame_count, outcome);
+#else
+    (void)iface;
+    for(uint16_t i = 0; i < frame_count; i++)
+    {
+        canardRemoveTxQueueFrame(&canard_, outcome);
+    }
+#endif
+}
+
+CanardTransportStatistics CanardInterface::getTransportStatistics() const
+{
+    CanardTransportStatistics stats = canardGetTransportStatistics(&canard_);
+
+    // The library only sees the frames handed to the I/O thread, which counts what became of them
+    for(uint8_t i = 0; i < num_ifaces_; i++)
+    {
+        const uint64_t sent = ifaces_[i].io_frames_tx.load(std::memory_order_relaxed);
+        const uint64_t dropped = ifaces_[i].io_frames_dropped.load(std::memory_order_relaxed);
+        stats.frames_tx += sent;
+        stats.tx_dropped += dropped;
+        if(i < CANARD_STATISTICS_MAX_IFACES)
+        {
+            stats.iface[i].frames_tx += sent;
+            stats.iface[i].errors += dropped;
+        }
+    }
+    return stats;
+}
+
+bool CanardInterface::hasPendingTx(uint8_t iface) const
+{
+    const CanardCANFrame* frame;
+    return peekTxFrames(iface, &frame, 1) != 0;
+}
+
+uint16_t CanardInterface::flushTxQueue(uint8_t iface)
+{
+    Iface &state = ifaces_[iface];
+    const CanardCANFrame* frames[SOCKETCAN_TX_BATCH_MAX];
+    uint16_t handled = 0;
+    uint16_t accepted = 0;
+    bool queue_full = false;
+
+    while(handled < CANARD_INTERFACE_TX_BUDGET)
+    {
+        const uint16_t budget = uint16_t(CANARD_INTERFACE_TX_BUDGET - handled);
+        const uint16_t count = peekTxFrames(iface, frames,
+                                            budget < SOCKETCAN_TX_BATCH_MAX ? budget : SOCKETCAN_TX_BATCH_MAX);
+        if(count == 0)
+        {
+            break;
+        }
+
+        const int16_t tx_res = socketcanTransmitBatch(&state.socketcan, frames, count, 0);
+        if(tx_res < 0)
+        {
+            // The frame cannot be sent, drop it so that it does not block the rest of the queue
+            std::cerr << "Transmit error " << tx_res << ", errno '" << strerror(errno) << "'" << std::endl;
+            popTxFrames(iface, 1, CanardTxFrameDropped);
+            handled++;
+            continue;
+        }
+
+        popTxFrames(iface, uint16_t(tx_res), CanardTxFrameTransmitted);
+        handled = uint16_t(handled + tx_res);
+        accepted = uint16_t(accepted + tx_res);
+
+        if(tx_res < count)
+        {
+            queue_full = true;
+            break;
+        }
+    }
+
+    updateTxState(state, accepted, queue_full, hasPendingTx(iface));
+
+    return accepted;
+}
+
+void CanardInterface::updateTxState(Iface &state, uint16_t accepted, bool queue_full, bool pending)
+{
+    const uint64_t now = monotonic_usec();
+
+    // Any progress ends the current blocked interval, a full queue starts a new one
+    const uint64_t blocked_since = state.tx_blocked_since_usec.load(std::memory_order_relaxed);
+    if(blocked_since != 0 && (accepted > 0 || !pending))
+    {
+        state.tx_blocked_usec.fetch_add(now - blocked_since, std::memory_order_relaxed);
+        state.tx_blocked_since_usec.store(0, std::memory_order_relaxed);
+    }
+    if(queue_full && state.tx_blocked_since_usec.load(std::memory_order_relaxed) == 0)
+    {
+        state.tx_blocked_since_usec.store(now, std::memory_order_relaxed);
+    }
+
+    // A full device queue (ENOBUFS) keeps the socket writable, so a flush that makes no progress at all means that
+    // waiting for POLLOUT would return immediately again. Back off instead of spinning until frames are accepted.
+    if(queue_full && accepted == 0)
+    {
+        state.tx_backoff_ms = (state.tx_backoff_ms == 0) ? CANARD_INTERFACE_TX_BACKOFF_MIN_MS : state.tx_backoff_ms * 2;
+        if(state.tx_backoff_ms > CANARD_INTERFACE_TX_BACKOFF_MAX_MS)
+        {
+            state.tx_backoff_ms = CANARD_INTERFACE_TX_BACKOFF_MAX_MS;
+        }
+        state.tx_retry_at_usec = now + state.tx_backoff_ms * 1000ULL;
+    }
+    else
+    {
+        state.tx_backoff_ms = 0;
+        state.tx_retry_at_usec = 0;
+    }
+}
+
+bool CanardInterface::txWantsWritable(uint8_t iface) const
+{
+    const Iface &state = ifaces_[iface];
+    return hasPendingTx(iface) && (state.tx_retry_at_usec == 0 || monotonic_usec() >= state.tx_retry_at_usec);
+}
+
+int32_t CanardInterface::txBackoffRemainingMs(uint8_t iface) const
+{
+    const Iface &state = ifaces_[iface];
+    if(state.tx_retry_at_usec == 0 || !hasPendingTx(iface))
+    {
+        return -1;
+    }
+    const uint64_t now = monotonic_usec();
+    if(now >= state.tx_retry_at_usec)
+    {
+        return 0;
+    }
+    return int32_t((state.tx_retry_at_usec - now + 999ULL) / 1000ULL);
+}
+
+uint64_t CanardInterface::getTxBlockedUsec(uint8_t iface) const
+{
+    const Iface &state = ifaces_[iface];
+    const uint64_t blocked_usec = state.tx_blocked_usec.load(std::memory_order_relaxed);
+    const uint64_t blocked_since = state.tx_blocked_since_usec.load(std::memory_order_relaxed);
+    if(blocked_since == 0)
+    {
+        return blocked_usec;
+    }
+    return blocked_usec + (monotonic_usec() - blocked_since);
+}
+
+void CanardInterface::updateFilters()
+{
+    const uint8_t node_id = canardGetLocalNodeID(&canard_);
+
+    SocketCANFilter filters[CANARD_INTERFACE_MAX_FILTERS];
+    uint16_t count = 0;
+    bool overflow = false;
+
+    auto add_filter = [&](uint32_t id, uint32_t mask) {
+        SocketCANFilter filter;
+        filter.id = id | uint32_t(CANARD_CAN_FRAME_EFF);
+        filter.mask = mask | uint32_t(CANARD_CAN_FRAME_EFF) | uint32_t(CANARD_CAN_FRAME_RTR);
+        for(uint16_t i = 0; i < count; i++)
+        {
+            if(filters[i].id == filter.id && filters[i].mask == filter.mask)
+            {
+                return;
+            }
+        }
+        if(count == CANARD_INTERFACE_MAX_FILTERS)
+        {
+            overflow = true;
+            return;
+        }
+        filters[count++] = filter;
+    };
+
+    Canard::HandlerList::for_each_handler(get_index(), [&](CanardTransferType transfer_type, uint16_t msgid) {
+        if(transfer_type == CanardTransferTypeBroadcast)
+        {
+            // Message type ID in bits 8..23, service-not-message bit 7 cleared
+            add_filter(uint32_t(msgid) << 8, (0xFFFFUL << 8) | 0x80U);
+            if(msgid < 4)
+            {
+                // Anonymous messages carry only the two lowest bits of the type ID and source node ID 0
+                add_filter(uint32_t(msgid) << 8, (0x3UL << 8) | 0x80U | 0x7FU);
+            }
+        }
+        else if(node_id != CANARD_BROADCAST_NODE_ID)
+        {
+            // Service type ID in bits 16..23, request-not-response bit 15, destination node ID in bits 8..14
+            const uint32_t request_bit = (transfer_type == CanardTransferTypeRequest) ? (1UL << 15) : 0U;
+            add_filter((uint32_t(msgid) << 16) | request_bit | (uint32_t(node_id) << 8) | 0x80U,
+                       (0xFFUL << 16) | (1UL << 15) | (0x7FUL << 8) | 0x80U);
+        }
+    });
+
+    for(uint8_t i = 0; i < num_ifaces_; i++)
+    {
+        const int16_t res = socketcanSetFilters(&ifaces_[i].socketcan, overflow ? nullptr : filters, count);
+        if(res < 0)
+        {
+            std::cerr << "Failed to install CAN filters " << res << ", errno '" << strerror(errno) << "'" << std::endl;
+        }
+    }
+
+    // Not retried on failure, the interface keeps receiving everything and the library keeps filtering
+    filters_valid_ = true;
+    filter_generation_ = Canard::HandlerList::get_generation(get_index());
+    filter_node_id_ = node_id;
+}
+
 void CanardInterface::process(uint32_t duration_ms)
 {
-    for(const CanardCANFrame* txf = NULL; (txf = canardPeekTxQueue(&canard_)) != NULL;)
+    cleanupStaleTransfers();
+
+    if(io_thread_running_)
+    {
+        // The I/O thread services the sockets, only wait for it to report work
+        serviceIoThread();
+        struct pollfd fds = {};
+        fds.fd = io_event_fd_;
+        fds.events = POLLIN;
+        if(poll(&fds, 1, int(duration_ms)) > 0)
+        {
+            serviceIoThread();
+        }
+        return;
+    }
+
+    const uint64_t deadline_usec = monotonic_usec() + duration_ms * 1000ULL;
+
+    // Wait for RX on all interfaces and, while frames are queued and not backing off, for TX readiness at the same
+    // time. Returns once frames have been received or the duration has elapsed.
+    for(;;)
+    {
+        const uint64_t now = monotonic_usec();
+        int32_t timeout_ms = (now < deadline_usec) ? int32_t((deadline_usec - now + 999ULL) / 1000ULL) : 0;
+
+        struct pollfd fds[CANARD_INTERFACE_MAX_IFACES] = {};
+        for(uint8_t i = 0; i < num_ifaces_; i++)
+        {
+            const int32_t backoff_ms = txBackoffRemainingMs(i);
+            if(backoff_ms >= 0 && backoff_ms < timeout_ms)
+            {
+                timeout_ms = backoff_ms;
+            }
+            fds[i].fd = getSocketFd(i);
+            fds[i].events = POLLIN | (txWantsWritable(i) ? POLLOUT : 0);
+        }
+
+        const int poll_res = poll(fds, num_ifaces_, timeout_ms);
+        if(poll_res < 0 && errno != EINTR)
+        {
+            std::cerr << "Poll error, errno '" << strerror(errno) << "'" << std::endl;
+            return;
+        }
+
+        bool received = false;
+        for(uint8_t i = 0; poll_res > 0 && i < num_ifaces_; i++)
+        {
+            if(fds[i].revents & POLLOUT)
+            {
+                flushTxQueue(i);
+            }
+            if(fds[i].revents & (POLLIN | POLLERR))
+            {
+                receiveFrames(i, 0);
+                received = true;
+            }
+        }
+        if(received || monotonic_usec() >= deadline_usec)
+        {
+            return;
+        }
+    }
+}
+
+void CanardInterface::refreshFilters()
+{
+    if(!filters_valid_ ||
+       filter_generation_ != Canard::HandlerList::get_generation(get_index()) ||
+       filter_node_id_ != canardGetLocalNodeID(&canard_))
+    {
+        updateFilters();
+    }
+}
+
+void CanardInterface::receiveFrames(uint8_t iface, int32_t timeout_ms)
+{
+    refreshFilters();
+
+    // Wait for the first batch, then drain everything that is ready without blocking
+    for(;;)
+    {
+        const int16_t rx_res = socketcanReceiveBatch(&ifaces_[iface].socketcan, rx_frames_, rx_timestamps_,
+                                                     SOCKETCAN_RX_BATCH_MAX, timeout_ms);
+        if(rx_res < 0)
+        {
+            std::cerr << "Receive error " << rx_res << ", errno '" << strerror(errno) << "'" << std::endl;
+            return;
+        }
+        if(rx_res == 0)
+        {
+            return;
+        }
+
+        // Driver timestamps are CLOCK_MONOTONIC, convert them to the micros64() time base
+        const uint64_t epoch = micros64_epoch();
+        for(int16_t i = 0; i < rx_res; i++)
+        {
+            rx_timestamps_[i] = (rx_timestamps_[i] > epoch) ? (rx_timestamps_[i] - epoch) : 0;
+        }
+        canardHandleRxFrames(&canard_, rx_frames_, rx_timestamps_, rx_res);
+
+        timeout_ms = 0;
+    }
+}
+
+bool CanardInterface::startIoThread(int cpu)
+{
+    if(io_thread_running_)
+    {
+        return true;
+    }
+
+    io_wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    io_event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(io_wakeup_fd_ < 0 || io_event_fd_ < 0)
+    {
+        std::cerr << "eventfd failed, errno '" << strerror(errno) << "'" << std::endl;
+        stopIoThread();
+        return false;
+    }
+
+    // Frames queued so far are handed over to the I/O thread, and the filters are set up before it starts reading
+    refreshFilters();
+    io_thread_stop_ = false;
+    io_thread_ = std::thread(&CanardInterface::ioThreadMain, this);
+    io_thread_running_ = true;
+
+    if(cpu >= 0)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        const int res = pthread_setaffinity_np(io_thread_.native_handle(), sizeof(cpus), &cpus);
+        if(res != 0)
+        {
+            std::cerr << "Failed to pin the I/O thread to CPU " << cpu << ", error '" << strerror(res) << "'" << std::endl;
+        }
+    }
+
+    flushTxToIoThread();
+    return true;
+}
+
+void CanardInterface::stopIoThread()
+{
+    if(io_thread_.joinable())
+    {
+        io_thread_stop_ = true;
+        const uint64_t one = 1;
+        (void)!write(io_wakeup_fd_, &one, sizeof(one));
+        io_thread_.join();
+    }
+    io_thread_running_ = false;
+
+    if(io_wakeup_fd_ >= 0)
+    {
+        close(io_wakeup_fd_);
+        io_wakeup_fd_ = -1;
+    }
+    if(io_event_fd_ >= 0)
+    {
+        close(io_event_fd_);
+        io_event_fd_ = -1;
+    }
+}
+
+void CanardInterface::serviceIoThread()
+{
+    uint64_t events = 0;
+    (void)!read(io_event_fd_, &events, sizeof(events));
+
+    refreshFilters();
+
+    for(;;)
+    {
+        const size_t available = rx_ring_.readAvailable();
+        if(available == 0)
+        {
+            break;
+        }
+
+        const uint16_t count = uint16_t((available < SOCKETCAN_RX_BATCH_MAX) ? available : SOCKETCAN_RX_BATCH_MAX);
+        for(uint16_t i = 0; i < count; i++)
+        {
+            const RxItem &item = rx_ring_.peek(i);
+            rx_frames_[i] = item.frame;
+            rx_timestamps_[i] = item.timestamp_usec;
+        }
+        rx_ring_.consume(count);
+
+        canardHandleRxFrames(&canard_, rx_frames_, rx_timestamps_, count);
+    }
+
+    flushTxToIoThread();
+}
+
+void CanardInterface::flushTxToIoThread()
+{
+    bool queued = false;
+    const CanardCANFrame* frames[SOCKETCAN_TX_BATCH_MAX];
+
+    for(uint8_t iface = 0; iface < num_ifaces_; iface++)
+    {
+        for(;;)
+        {
+            const uint16_t count = peekTxFrames(iface, frames, SOCKETCAN_TX_BATCH_MAX);
+            uint16_t pushed = 0;
+            while(pushed < count)
+            {
+                if(!tx_rings_[iface].push(*frames[pushed]))
+                {
+                    // Ask the I/O thread to report back once it has made room, then retry in case it already has.
+                    // Pairs with the fence in ioTransmit(), so that one side always sees the other's update.
+                    tx_ring_full_[iface] = true;
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if(!tx_rings_[iface].push(*frames[pushed]))
+                    {
+                        break;
+                    }
+                }
+                pushed++;
+            }
+            popTxFrames(iface, pushed, CanardTxFrameHandedOff);
+            queued = queued || (pushed > 0);
+
+            if(pushed < count)
+            {
+                break;
+            }
+            if(count < SOCKETCAN_TX_BATCH_MAX)
+            {
+                break;
+            }
+        }
+    }
+
+    if(queued)
+    {
+        const uint64_t one = 1;
+        (void)!write(io_wakeup_fd_, &one, sizeof(one));
+    }
+}
+
+void CanardInterface::signalIoEvent()
+{
+    const uint64_t one = 1;
+    (void)!write(io_event_fd_, &one, sizeof(one));
+}
+
+void CanardInterface::ioThreadMain()
+{
+    struct pollfd fds[CANARD_INTERFACE_MAX_IFACES + 1];
+
+    while(!io_thread_stop_)
     {
-        const int16_t tx_res = socketcanTransmit(&socketcan_, txf, 0);
-        if(tx_res != 0)
+        // Nothing but the sockets and the wakeup eventfd is touched here, the CanardInstance belongs to the
+        // protocol thread
+        int32_t timeout_ms = -1;
+        for(uint8_t i = 0; i < num_ifaces_; i++)
+        {
+            const Iface &state = ifaces_[i];
+            const bool pending = !tx_rings_[i].empty();
+            bool backing_off = false;
+            if(pending && state.tx_retry_at_usec != 0)
+            {
+                const uint64_t now = monotonic_usec();
+                if(now < state.tx_retry_at_usec)
+                {
+                    const int32_t backoff_ms = int32_t((state.tx_retry_at_usec - now + 999ULL) / 1000ULL);
+                    timeout_ms = (timeout_ms < 0 || backoff_ms < timeout_ms) ? backoff_ms : timeout_ms;
+                    backing_off = true;
+                }
+            }
+            fds[i].fd = getSocketFd(i);
+            fds[i].events = POLLIN | ((pending && !backing_off) ? POLLOUT : 0);
+            fds[i].revents = 0;
+        }
+        fds[num_ifaces_].fd = io_wakeup_fd_;
+        fds[num_ifaces_].events = POLLIN;
+        fds[num_ifaces_].revents = 0;
+
+        const int poll_res = poll(fds, num_ifaces_ + 1, timeout_ms);
+        if(poll_res < 0 && errno != EINTR)
+        {
+            std::cerr << "I/O thread poll error, errno '" << strerror(errno) << "'" << std::endl;
+            return;
+        }
+        if(poll_res <= 0)
         {
-            canardPopTxQueue(&canard_);
+            continue;
+        }
+
+        if(fds[num_ifaces_].revents & POLLIN)
+        {
+            uint64_t value = 0;
+            (void)!read(io_wakeup_fd_, &value, sizeof(value));
+        }
+
+        for(uint8_t i = 0; i < num_ifaces_; i++)
+        {
+            if(fds[i].revents & (POLLIN | POLLERR))
+            {
+                ioReceive(i);
+            }
+            if(fds[i].revents & POLLOUT)
+            {
+                ioTransmit(i);
+            }
         }
     }
+}
+
+void CanardInterface::ioReceive(uint8_t iface)
+{
+    CanardCANFrame frames[SOCKETCAN_RX_BATCH_MAX];
+    uint64_t timestamps[SOCKETCAN_RX_BATCH_MAX];
+    bool queued = false;
 
-    CanardCANFrame rx_frame;
+    for(;;)
+    {
+        const int16_t rx_res = socketcanReceiveBatch(&ifaces_[iface].socketcan, frames, timestamps,
+                                                     SOCKETCAN_RX_BATCH_MAX, 0);
+        if(rx_res < 0)
+        {
+            std::cerr << "Receive error " << rx_res << ", errno '" << strerror(errno) << "'" << std::endl;
+            break;
+        }
+        if(rx_res == 0)
+        {
+            break;
+        }
 
-    const uint64_t timestamp = micros64();
-    const int16_t rx_res = socketcanReceive(&socketcan_, &rx_frame, duration_ms);
+        // Driver timestamps are CLOCK_MONOTONIC, convert them to the micros64() time base
+        const uint64_t epoch = micros64_epoch();
+        for(int16_t i = 0; i < rx_res; i++)
+        {
+            RxItem item;
+            item.frame = frames[i];
+            item.timestamp_usec = (timestamps[i] > epoch) ? (timestamps[i] - epoch) : 0;
+            if(rx_ring_.push(item))
+            {
+                queued = true;
+            }
+            else
+            {
+                rx_ring_overruns_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
 
-    if(rx_res > 0)
+    if(queued)
     {
-        canardHandleRxFrame(&canard_, &rx_frame, timestamp);
+        signalIoEvent();
     }
-    else if(rx_res < 0)
+}
+
+void CanardInterface::ioTransmit(uint8_t iface)
+{
+    SpscRing<CanardCANFrame, CANARD_INTERFACE_TX_RING_SIZE> &ring = tx_rings_[iface];
+    const CanardCANFrame* frames[SOCKETCAN_TX_BATCH_MAX];
+    uint16_t accepted = 0;
+    bool queue_full = false;
+
+    for(;;)
     {
-        std::cerr << "Receive error " << rx_res << ", errno '" << strerror(errno) << "'" << std::endl;
+        const size_t available = ring.readAvailable();
+        if(available == 0)
+        {
+            break;
+        }
+
+        const uint16_t count = uint16_t((available < SOCKETCAN_TX_BATCH_MAX) ? available : SOCKETCAN_TX_BATCH_MAX);
+        for(uint16_t i = 0; i < count; i++)
+        {
+            frames[i] = &ring.peek(i);
+        }
+
+        const int16_t tx_res = socketcanTransmitBatch(&ifaces_[iface].socketcan, frames, count, 0);
+        if(tx_res < 0)
+        {
+            // The frame cannot be sent, drop it so that it does not block the rest of the ring
+            std::cerr << "Transmit error " << tx_res << ", errno '" << strerror(errno) << "'" << std::endl;
+            ring.consume(1);
+            ifaces_[iface].io_frames_dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        ring.consume(size_t(tx_res));
+        ifaces_[iface].io_frames_tx.fetch_add(uint64_t(tx_res), std::memory_order_relaxed);
+        accepted = uint16_t(accepted + tx_res);
+        if(tx_res < count)
+        {
+            queue_full = true;
+            break;
+        }
     }
 
+    updateTxState(ifaces_[iface], accepted, queue_full, !ring.empty());
+
+    // Let the protocol thread move the frames it could not fit into the ring
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(accepted > 0 && tx_ring_full_[iface].exchange(false))
+    {
+        signalIoEvent();
+    }
 }
 
 void CanardInterface::onTransferReceived(CanardInstance *ins, CanardRxTransfer *transfer)
@@ -109,5 +853,5 @@ CanardTransferType transfer_type,
 uint8_t source_node_id)
 {
     CanardInterface *iface = (CanardInterface *)ins->user_reference;
-    return iface->accept_message(data_type_id, *out_data_type_signature);
+    return iface->accept_message(transfer_type, data_type_id, *out_data_type_signature);
 }
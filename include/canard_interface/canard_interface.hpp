@@ -10,6 +10,8 @@
 #include <assert.h>
 #include <errno.h>
 #include <stdbool.h>
+#include <atomic>
+#include <thread>
 
 // include the canard C++ APIs
 #include "canard/publisher.h"
@@ -25,27 +27,95 @@
 // include the interface
 #include "driver/socketcan.h"
 
+#include "canard_interface/spsc_ring.hpp"
 
-static uint64_t micros64()
+
+// Time helpers are inline rather than static so that all translation units share the same epoch
+
+// Current CLOCK_MONOTONIC time in microseconds, the time base of the socketcan driver timestamps
+inline uint64_t monotonic_usec()
 {
-    static uint64_t first_us;
     struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
-    uint64_t tus = (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// CLOCK_MONOTONIC time at which micros64() started counting
+inline uint64_t micros64_epoch()
+{
+    static uint64_t first_us;
     if(first_us == 0)
     {
-        first_us = tus;
+        first_us = monotonic_usec();
     }
+    return first_us;
+}
 
-    return tus - first_us;
-
+inline uint64_t micros64()
+{
+    const uint64_t epoch = micros64_epoch();
+    return monotonic_usec() - epoch;
 }
 
-static uint32_t millis32()
+inline uint32_t millis32()
 {
     return micros64() / 1000ULL;
 }
 
+// Maximum number of frames handed to the driver by one flushTxQueue() call, so that a long backlog cannot starve RX
+#ifndef CANARD_INTERFACE_TX_BUDGET
+#define CANARD_INTERFACE_TX_BUDGET 64
+#endif
+
+// Bounds of the exponential TX backoff used while the kernel refuses frames despite reporting writability
+#ifndef CANARD_INTERFACE_TX_BACKOFF_MIN_MS
+#define CANARD_INTERFACE_TX_BACKOFF_MIN_MS 1
+#endif
+#ifndef CANARD_INTERFACE_TX_BACKOFF_MAX_MS
+#define CANARD_INTERFACE_TX_BACKOFF_MAX_MS 64
+#endif
+
+// Maximum number of kernel acceptance filters, the interface accepts all frames if more are needed
+#ifndef CANARD_INTERFACE_MAX_FILTERS
+#define CANARD_INTERFACE_MAX_FILTERS 64
+#endif
+
+// Default size of the library memory pool for received transfers in CANARD_RX_BLOCK_SIZE blocks, see
+// CanardInterface::setPoolConfig(). Not all of them hold transfers: the RX state hash table takes the first
+// CANARD_RX_STATE_HASH_BUCKETS * 4 bytes, and every remaining block needs a 4 byte timer wheel link, so a block costs
+// CANARD_RX_BLOCK_SIZE + 4 bytes. The default leaves 64 usable blocks, as many as the former 2 KB pool.
+#ifndef CANARD_INTERFACE_POOL_BLOCKS
+#define CANARD_INTERFACE_POOL_BLOCKS 80
+#endif
+
+// Default size of the separate TX queue pool in blocks, so that a TX backlog cannot starve reception. A block holds one
+// queued TX frame, so the same number of blocks gives the same TX queue depth with classic CAN and CAN FD frames.
+#ifndef CANARD_INTERFACE_TX_POOL_BLOCKS
+#define CANARD_INTERFACE_TX_POOL_BLOCKS 64
+#endif
+
+// Depth of the rings between the I/O thread and the protocol thread, see CanardInterface::startIoThread().
+// The TX ring is a FIFO, so it only holds the few frames the I/O thread is about to send; the rest wait in the
+// priority ordered TX queue of the library, where a more urgent frame can still overtake them.
+#ifndef CANARD_INTERFACE_RX_RING_SIZE
+#define CANARD_INTERFACE_RX_RING_SIZE 256
+#endif
+#ifndef CANARD_INTERFACE_TX_RING_SIZE
+#define CANARD_INTERFACE_TX_RING_SIZE 8
+#endif
+
+// Number of redundant CAN interfaces a CanardInterface can drive, limited by the 8 bit iface_mask
+#ifndef CANARD_INTERFACE_MAX_IFACES
+#if CANARD_MULTI_IFACE
+#define CANARD_INTERFACE_MAX_IFACES 2
+#else
+#define CANARD_INTERFACE_MAX_IFACES 1
+#endif
+#endif
+
+static_assert(CANARD_INTERFACE_MAX_IFACES >= 1 && CANARD_INTERFACE_MAX_IFACES <= 8, "Invalid number of interfaces");
+static_assert(CANARD_MULTI_IFACE || CANARD_INTERFACE_MAX_IFACES == 1, "Several interfaces require CANARD_MULTI_IFACE");
+
 class CanardInterface : public Canard::Interface{
 
 
@@ -57,8 +127,35 @@ class CanardInterface : public Canard::Interface{
         : Interface(iface_index)
         {}
 
+        ~CanardInterface()
+        {
+            stopIoThread();
+            releasePools();
+        }
+
+        /// Sizes of the library memory pools, which are mapped at run time so that large nodes such as gateways can
+        /// reassemble many concurrent transfers
+        struct PoolConfig {
+            uint32_t rx_blocks = CANARD_INTERFACE_POOL_BLOCKS;      ///< Pool for received transfers, incl. the RX state table
+            uint32_t tx_blocks = CANARD_INTERFACE_TX_POOL_BLOCKS;   ///< Pool for queued TX frames
+            bool hugepages = false;             ///< Back the pools with explicit huge pages if the system has any reserved
+        };
+
+        /// Sets the pool sizes used by the next init(). The pools are prefaulted so that the first transfers do not take
+        /// page faults, and with hugepages they are mapped with MAP_HUGETLB, falling back to normal pages if that fails.
+        void setPoolConfig(const PoolConfig &config)
+        {
+            pool_config_ = config;
+        }
+
         // Implement the Canard::Interface pure virtual functions
-        void init(const char *interface_name);
+        void init(const char *interface_name, bool canfd = false);
+
+        /// Opens one socket per CAN bus. Transfers are sent on every bus in their iface_mask, and the duplicates
+        /// received from the redundant buses are discarded by the library.
+        /// With canfd the sockets accept CAN FD frames, and transfers are sent as CAN FD with bit rate switching
+        /// unless the sender asks for classic CAN. Requires CANARD_ENABLE_CANFD.
+        void init(const char *const *interface_names, uint8_t num_ifaces, bool canfd = false);
 
         bool broadcast(const Canard::Transfer &transfer) override;
         
@@ -75,6 +172,106 @@ class CanardInterface : public Canard::Interface{
 
         void process(uint32_t duration_ms);
 
+        /// Receives and handles every frame that arrives on the interface within timeout_ms, returning as soon as the
+        /// socket is drained. Zero timeout only handles the frames that are already pending.
+        void receiveFrames(uint8_t iface, int32_t timeout_ms);
+
+        uint8_t getNumIfaces() const
+        {
+            return num_ifaces_;
+        }
+
+        /// True while the TX queue holds frames that have not been handed to the driver of the interface yet
+        bool hasPendingTx(uint8_t iface) const;
+
+        /// File descriptor of the CAN socket of the interface, for external readiness multiplexing
+        int getSocketFd(uint8_t iface) const
+        {
+            return socketcanGetSocketFileDescriptor(&ifaces_[iface].socketcan);
+        }
+
+        /// Frees the RX states of transfers that have not been updated for two seconds, along with their partially
+        /// received payload. Only touches states that are due, so it can be called every loop iteration.
+        /// Called by process() and periodically by an EventLoop.
+        void cleanupStaleTransfers()
+        {
+            canardCleanupStaleTransfers(&canard_, micros64());
+        }
+
+        /// Rebuilds the kernel acceptance filters from the registered handlers and the local node ID.
+        /// Called by process() whenever either of them changes.
+        void updateFilters();
+
+        /// Hands up to CANARD_INTERFACE_TX_BUDGET queued frames to the driver of the interface in batches without
+        /// blocking, stopping at the first batch the kernel does not fully accept. Every frame accepted by the kernel is
+        /// marked as sent on the interface, and removed from the queue once it has been sent on all of its interfaces.
+        /// Returns the number of frames accepted.
+        uint16_t flushTxQueue(uint8_t iface);
+
+        /// True if frames are queued and the interface is not backing off, i.e. socket writability is worth waiting for
+        bool txWantsWritable(uint8_t iface) const;
+
+        /// Milliseconds until the TX backoff of the interface ends, -1 if it is not backing off
+        int32_t txBackoffRemainingMs(uint8_t iface) const;
+
+        /// Number of frames waiting in the TX queue
+        uint32_t getTxBacklog() const
+        {
+            return canardGetTxQueueLength(&canard_);
+        }
+
+        /// Usage of the memory pool for received transfers
+        CanardPoolAllocatorStatistics getRxPoolStatistics()
+        {
+            return canardGetPoolAllocatorStatistics(&canard_);
+        }
+
+        /// Usage of the memory pool for queued TX frames
+        CanardPoolAllocatorStatistics getTxPoolStatistics()
+        {
+            return canardGetTxPoolAllocatorStatistics(&canard_);
+        }
+
+        /// Frame, transfer and error counters of the library instance, per bus for the first CANARD_STATISTICS_MAX_IFACES.
+        /// Frames sent by the I/O thread are counted once the driver has accepted or rejected them.
+        CanardTransportStatistics getTransportStatistics() const;
+
+        /// Total time the interface has spent unable to make progress because the kernel queue was full, in microseconds
+        uint64_t getTxBlockedUsec(uint8_t iface) const;
+
+        /// Moves socket servicing to a dedicated thread, optionally pinned to a CPU (negative to leave it unpinned).
+        /// The I/O thread owns the sockets: it pushes received frames with their timestamps into an SPSC ring as soon
+        /// as they arrive, and sends the frames it finds in the per bus TX rings. The library and all handlers stay on
+        /// the calling thread, which drains the rings in process() or through an EventLoop, so slow handlers no longer
+        /// delay reading the sockets. Must be called after init() and before adding the interface to an EventLoop.
+        bool startIoThread(int cpu = -1);
+
+        void stopIoThread();
+
+        bool isIoThreadRunning() const
+        {
+            return io_thread_running_;
+        }
+
+        /// Becomes readable whenever the I/O thread has queued received frames or freed TX ring space
+        int getIoEventFd() const
+        {
+            return io_event_fd_;
+        }
+
+        /// Protocol thread: handles the frames received by the I/O thread and hands it the queued TX frames
+        void serviceIoThread();
+
+        /// Protocol thread: moves frames from the front of the TX queue to the TX rings of the I/O thread until they are
+        /// full. The I/O thread reports back once it has sent some of them, and the rings are topped up again.
+        void flushTxToIoThread();
+
+        /// Received frames dropped because the protocol thread did not drain the RX ring in time
+        uint32_t getRxRingOverruns() const
+        {
+            return rx_ring_overruns_.load(std::memory_order_relaxed);
+        }
+
         static void onTransferReceived(CanardInstance* ins,
                                     CanardRxTransfer* transfer);
         
@@ -87,12 +284,69 @@ class CanardInterface : public Canard::Interface{
 
     private:
 
-        uint8_t memory_pool_[2048];
+        // TX state is owned by the thread that sends, the blocked time counters can be read from any thread
+        struct Iface {
+            SocketCANInstance socketcan;
+            std::atomic<uint64_t> tx_blocked_usec;          ///< Sum of the finished blocked intervals
+            std::atomic<uint64_t> tx_blocked_since_usec;    ///< Start of the current blocked interval, 0 if not blocked
+            std::atomic<uint64_t> io_frames_tx;             ///< Frames sent by the I/O thread
+            std::atomic<uint64_t> io_frames_dropped;        ///< Frames the driver rejected on the I/O thread
+            uint64_t tx_retry_at_usec;          ///< End of the current backoff, 0 if not backing off
+            uint32_t tx_backoff_ms;
+        };
+
+        struct Pool {
+            void *base;
+            size_t size;                        ///< Mapped length in bytes
+        };
+
+        struct RxItem {
+            CanardCANFrame frame;
+            uint64_t timestamp_usec;            ///< micros64() time base
+        };
+
+        uint16_t peekTxFrames(uint8_t iface, const CanardCANFrame** frames, uint16_t max_frames) const;
+        void setTxTransfer(const Canard::Transfer &transfer);
+        void popTxFrames(uint8_t iface, uint16_t frame_count, CanardTxFrameOutcome outcome);
+        void updateTxState(Iface &state, uint16_t accepted, bool queue_full, bool pending);
+        void refreshFilters();
+
+        void ioThreadMain();
+        void ioReceive(uint8_t iface);
+        void ioTransmit(uint8_t iface);
+        void signalIoEvent();
+
+        void mapPool(Pool &pool, size_t size);
+        void releasePools();
+
+        PoolConfig pool_config_;
+        Pool rx_pool_ = {};
+        Pool tx_pool_ = {};
+        uint8_t rx_reassembly_buffer_[CANARD_MAX_TRANSFER_PAYLOAD_LEN];
         CanardInstance canard_;
         CanardTxTransfer tx_transfer_;
 
-        SocketCANInstance socketcan_;
+        Iface ifaces_[CANARD_INTERFACE_MAX_IFACES] = {};
+        uint8_t num_ifaces_ = 0;
+
+        bool filters_valid_ = false;
+        uint32_t filter_generation_ = 0;
+        uint8_t filter_node_id_ = CANARD_BROADCAST_NODE_ID;
+
+        CanardCANFrame rx_frames_[SOCKETCAN_RX_BATCH_MAX];
+        uint64_t rx_timestamps_[SOCKETCAN_RX_BATCH_MAX];
+
+        std::thread io_thread_;
+        std::atomic<bool> io_thread_running_{false};
+        std::atomic<bool> io_thread_stop_{false};
+        int io_wakeup_fd_ = -1;                 ///< Protocol thread to I/O thread: TX frames queued or stop requested
+        int io_event_fd_ = -1;                  ///< I/O thread to protocol thread: RX frames queued or TX ring space freed
+        std::atomic<bool> tx_ring_full_[CANARD_INTERFACE_MAX_IFACES] = {};
+        std::atomic<uint32_t> rx_ring_overruns_{0};
+
+        SpscRing<RxItem, CANARD_INTERFACE_RX_RING_SIZE> rx_ring_;
+        SpscRing<CanardCANFrame, CANARD_INTERFACE_TX_RING_SIZE> tx_rings_[CANARD_INTERFACE_MAX_IFACES];
 
 };
 
-#endif // CANARD_INTERFACE_HPP
\ No newline at end of file
+#endif // CANARD_INTERFACE_HPP
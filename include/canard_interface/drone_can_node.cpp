@@ -1,53 +1,64 @@
 #include "drone_can_node.hpp"
 
 
-void DroneCanNode::start_node(const char *interface_name)
+void DroneCanNode::start_node(const char *interface_name, bool canfd)
 {
-    canard_iface_.init(interface_name);
+    start_node(&interface_name, 1, canfd);
+}
+
+void DroneCanNode::start_node(const char *const *interface_names, uint8_t num_ifaces, bool canfd)
+{
+    canard_iface_.init(interface_names, num_ifaces, canfd);
+
+    // Handlers such as handle_EscStatus print to the console, keep that latency away from the sockets
+    if(io_thread_ && !canard_iface_.startIoThread(io_thread_cpu_))
+    {
+        exit(EXIT_FAILURE);
+    }
 
-    uint8_t node_id = canard_iface_.get_node_id();
+    if(!event_loop_.init() || !event_loop_.addInterface(canard_iface_))
+    {
+        exit(EXIT_FAILURE);
+    }
 
     int32_t operation[4] = {10, 10, 10, 10};
     int16_t raw[4] = {10, 10, 10, 10};
 
-    printf("DroneCanNode started on %s, node ID %d\n", 
-    interface_name, canard_iface_.get_node_id());
+    printf("DroneCanNode started on");
+    for(uint8_t i = 0; i < num_ifaces; i++) {
+        printf(" %s", interface_names[i]);
+    }
+    printf(", node ID %d%s\n", canard_iface_.get_node_id(), canfd ? ", CAN FD" : "");
 
     /*
-      Run the main loop.
+      Run the main loop. Everything below is driven by socket readiness and timers.
      */
-    uint64_t next_1hz_service_at = micros64();
-
     send_NodeStatus();
-    canard_iface_.process(10);
+    event_loop_.addPeriodicTimer(1000000ULL, [this]() { send_NodeStatus(); });
 
-    uavcan_protocol_GetNodeInfoRequest req;
-    
-    for(size_t i = 1; i < 5; i++) {
-        
-        printf("Requesting node info for node %ld\n", i);
-        req = {};
-        while(!get_node_info_client_.request(i,req))
-        {
-            canard_iface_.process(10);
-        };
-    }
+    request_NodeInfo();
 
     // broadcast_RPMCommand(operation);
 
     broadcast_RawCommand(raw);
 
+    event_loop_.run();
+}
 
-    while (true) {
-    
-        uint64_t ts = micros64();
+void DroneCanNode::request_NodeInfo()
+{
+    uavcan_protocol_GetNodeInfoRequest req;
 
-        if (ts >= next_1hz_service_at) {
-            next_1hz_service_at += 1000000ULL;
-            send_NodeStatus();
-        }
+    while(next_node_info_id_ <= NUM_NODE_INFO_REQUESTS) {
 
-        canard_iface_.process(10);
+        req = {};
+        if(!get_node_info_client_.request(next_node_info_id_, req)) {
+            // The TX queue is full, try again once some of it has been sent
+            event_loop_.addOneShotTimer(NODE_INFO_RETRY_PERIOD_US, [this]() { request_NodeInfo(); });
+            return;
+        }
+        printf("Requesting node info for node %d\n", next_node_info_id_);
+        next_node_info_id_++;
     }
 }
 
@@ -127,6 +138,37 @@ const uavcan_protocol_GetNodeInfoResponse &rsp)
     printf("\n");
 
 }
+
+void DroneCanNode::handle_GetTransportStats(const CanardRxTransfer &transfer,
+const uavcan_protocol_GetTransportStatsRequest &req)
+{
+    (void)req;
+
+    const CanardTransportStatistics stats = canard_iface_.getTransportStatistics();
+
+    uavcan_protocol_GetTransportStatsResponse rsp {};
+    rsp.transfers_tx = stats.transfers_tx;
+    rsp.transfers_rx = stats.transfers_rx;
+    rsp.transfer_errors = stats.transfer_errors;
+
+    // The response has room for three buses, the counters of the library may have fewer
+    uint8_t num_ifaces = canard_iface_.getNumIfaces();
+    if(num_ifaces > CANARD_STATISTICS_MAX_IFACES) {
+        num_ifaces = CANARD_STATISTICS_MAX_IFACES;
+    }
+    if(num_ifaces > sizeof(rsp.can_iface_stats.data) / sizeof(rsp.can_iface_stats.data[0])) {
+        num_ifaces = sizeof(rsp.can_iface_stats.data) / sizeof(rsp.can_iface_stats.data[0]);
+    }
+    rsp.can_iface_stats.len = num_ifaces;
+    for(uint8_t i = 0; i < num_ifaces; i++) {
+        rsp.can_iface_stats.data[i].frames_tx = stats.iface[i].frames_tx;
+        rsp.can_iface_stats.data[i].frames_rx = stats.iface[i].frames_rx;
+        rsp.can_iface_stats.data[i].errors = stats.iface[i].errors;
+    }
+
+    get_transport_stats_server_.respond(transfer, rsp);
+}
+
 void DroneCanNode::send_NodeStatus()
 {
 
@@ -2,20 +2,47 @@
 #define DRONE_CAN_NODE_HPP
 #include "dsdl_generated/dronecan_msgs.h"
 #include "canard_interface/canard_interface.hpp"
+#include "canard_interface/event_loop.hpp"
 
 #define NUM_ESCS 4
 
+// Number of ESC nodes queried with GetNodeInfo at startup, starting at node ID 1
+#define NUM_NODE_INFO_REQUESTS 4
+
+// Retry period of a GetNodeInfo request that could not be queued
+#define NODE_INFO_RETRY_PERIOD_US 10000ULL
+
 class CanardInterface;
 
 class DroneCanNode
 {
     public:
 
-        void start_node(const char *interface_name);
+        /// Services the CAN sockets from a dedicated I/O thread, optionally pinned to a CPU. Call before start_node().
+        void enable_io_thread(int cpu = -1)
+        {
+            io_thread_ = true;
+            io_thread_cpu_ = cpu;
+        }
+
+        /// Sizes the library memory pools, see CanardInterface::setPoolConfig(). Call before start_node().
+        void set_pool_config(const CanardInterface::PoolConfig &config)
+        {
+            canard_iface_.setPoolConfig(config);
+        }
+
+        void start_node(const char *interface_name, bool canfd = false);
+
+        /// Runs the node on several redundant CAN buses, requires CANARD_MULTI_IFACE for more than one.
+        /// With canfd all transfers are sent as CAN FD, which requires CANARD_ENABLE_CANFD.
+        void start_node(const char *const *interface_names, uint8_t num_ifaces, bool canfd = false);
 
     private:
 
         CanardInterface canard_iface_{0};
+        EventLoop event_loop_;
+        bool io_thread_{false};
+        int io_thread_cpu_{-1};
         
         Canard::Publisher<uavcan_protocol_NodeStatus> node_status_pub_{canard_iface_};
         Canard::Publisher<uavcan_equipment_esc_RPMCommand> esc_rpm_pub_{canard_iface_};
@@ -29,8 +56,15 @@ class DroneCanNode
         Canard::ObjCallback<DroneCanNode, uavcan_protocol_GetNodeInfoResponse> get_node_info_cb_{this, &DroneCanNode::handle_GetNodeInfo};
         Canard::Client<uavcan_protocol_GetNodeInfoResponse> get_node_info_client_{canard_iface_, get_node_info_cb_};
 
+        void handle_GetTransportStats(const CanardRxTransfer& transfer, const uavcan_protocol_GetTransportStatsRequest& req);
+        Canard::ObjCallback<DroneCanNode, uavcan_protocol_GetTransportStatsRequest> get_transport_stats_cb_{this, &DroneCanNode::handle_GetTransportStats};
+        Canard::Server<uavcan_protocol_GetTransportStatsRequest> get_transport_stats_server_{canard_iface_, get_transport_stats_cb_};
+
         void send_NodeStatus();
 
+        void request_NodeInfo();
+        uint8_t next_node_info_id_{1};
+
         void broadcast_RPMCommand(int32_t rpm[NUM_ESCS]);
 
         void broadcast_RawCommand(int16_t throttle[NUM_ESCS]);
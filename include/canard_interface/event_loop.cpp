@@ -0,0 +1,330 @@
+#include "event_loop.hpp"
+#include "canard_interface.hpp"
+
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+EventLoop::~EventLoop()
+{
+    for(auto &source : sources_)
+    {
+        if(source->type != SourceType::Interface && source->type != SourceType::IoThread)
+        {
+            close(source->fd);
+        }
+    }
+    if(epoll_fd_ >= 0)
+    {
+        close(epoll_fd_);
+    }
+}
+
+bool EventLoop::init()
+{
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if(epoll_fd_ < 0)
+    {
+        std::cerr << "epoll_create1 failed, errno '" << strerror(errno) << "'" << std::endl;
+        return false;
+    }
+
+    wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(wakeup_fd_ < 0)
+    {
+        std::cerr << "eventfd failed, errno '" << strerror(errno) << "'" << std::endl;
+        return false;
+    }
+
+    std::unique_ptr<Source> source(new Source{SourceType::Wakeup, wakeup_fd_, false, false, nullptr, 0, nullptr});
+
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.ptr = source.get();
+    if(epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &ev) < 0)
+    {
+        close(wakeup_fd_);
+        wakeup_fd_ = -1;
+        return false;
+    }
+
+    sources_.push_back(std::move(source));
+    return true;
+}
+
+bool EventLoop::addInterface(CanardInterface &iface)
+{
+    // Stale RX states are expired one timer wheel tick at a time, so they never pile up until the pool runs out
+    if(addPeriodicTimer(CANARD_RX_TIMER_WHEEL_TICK_USEC, [&iface]() { iface.cleanupStaleTransfers(); }) < 0)
+    {
+        std::cerr << "Failed to add the stale transfer cleanup timer" << std::endl;
+        return false;
+    }
+
+    if(iface.isIoThreadRunning())
+    {
+        const int fd = iface.getIoEventFd();
+        std::unique_ptr<Source> source(new Source{SourceType::IoThread, fd, false, false, &iface, 0, nullptr});
+
+        struct epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.ptr = source.get();
+        if(epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0)
+        {
+            std::cerr << "Failed to add the I/O thread eventfd to epoll, errno '" << strerror(errno) << "'" << std::endl;
+            return false;
+        }
+
+        sources_.push_back(std::move(source));
+        return true;
+    }
+
+    for(uint8_t i = 0; i < iface.getNumIfaces(); i++)
+    {
+        const int fd = iface.getSocketFd(i);
+        std::unique_ptr<Source> source(new Source{SourceType::Interface, fd, false, false, &iface, i, nullptr});
+
+        struct epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.ptr = source.get();
+        if(epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0)
+        {
+            std::cerr << "Failed to add the CAN socket to epoll, errno '" << strerror(errno) << "'" << std::endl;
+            return false;
+        }
+
+        sources_.push_back(std::move(source));
+    }
+    return true;
+}
+
+int EventLoop::addPeriodicTimer(uint64_t period_us, TimerCallback callback)
+{
+    if(period_us == 0)
+    {
+        return -EINVAL;
+    }
+    return addTimer(SourceType::PeriodicTimer, period_us, period_us, std::move(callback));
+}
+
+int EventLoop::addOneShotTimer(uint64_t delay_us, TimerCallback callback)
+{
+    return addTimer(SourceType::OneShotTimer, delay_us, 0, std::move(callback));
+}
+
+int EventLoop::addTimer(SourceType type, uint64_t delay_us, uint64_t period_us, TimerCallback callback)
+{
+    const int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if(fd < 0)
+    {
+        return -errno;
+    }
+
+    // The first expiry is absolute so that the period is measured from now rather than from when the kernel gets to it.
+    // A zero it_value would disarm the timer, so an immediate one-shot is scheduled for the current time instead.
+    const uint64_t first_us = monotonic_usec() + delay_us;
+    struct itimerspec spec = {};
+    spec.it_value.tv_sec = time_t(first_us / 1000000ULL);
+    spec.it_value.tv_nsec = long((first_us % 1000000ULL) * 1000ULL);
+    spec.it_interval.tv_sec = time_t(period_us / 1000000ULL);
+    spec.it_interval.tv_nsec = long((period_us % 1000000ULL) * 1000ULL);
+    if(timerfd_settime(fd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0)
+    {
+        const int err = errno;
+        close(fd);
+        return -err;
+    }
+
+    std::unique_ptr<Source> source(new Source{type, fd, false, false, nullptr, 0, std::move(callback)});
+
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.ptr = source.get();
+    if(epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0)
+    {
+        const int err = errno;
+        close(fd);
+        return -err;
+    }
+
+    sources_.push_back(std::move(source));
+    return fd;
+}
+
+bool EventLoop::cancelTimer(int timer_id)
+{
+    for(auto &source : sources_)
+    {
+        if(source->fd == timer_id && !source->removed &&
+           (source->type == SourceType::PeriodicTimer || source->type == SourceType::OneShotTimer))
+        {
+            // The descriptor stays open until the end of the iteration, so a pending event for it cannot be
+            // confused with a new timer that reuses the same number
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, source->fd, nullptr);
+            source->removed = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool EventLoop::runOnce(int32_t timeout_ms)
+{
+    updateTxInterest();
+
+    // Interfaces that are backing off from a full TX queue are not waiting for EPOLLOUT, wake up when they may retry
+    for(auto &source : sources_)
+    {
+        if(source->type == SourceType::Interface)
+        {
+            const int32_t backoff_ms = source->iface->txBackoffRemainingMs(source->iface_id);
+            if(backoff_ms >= 0 && (timeout_ms < 0 || backoff_ms < timeout_ms))
+            {
+                timeout_ms = backoff_ms;
+            }
+        }
+    }
+
+    struct epoll_event events[max_events_];
+    const int count = epoll_wait(epoll_fd_, events, max_events_, timeout_ms);
+    if(count < 0)
+    {
+        if(errno == EINTR)
+        {
+            return true;
+        }
+        std::cerr << "epoll_wait failed, errno '" << strerror(errno) << "'" << std::endl;
+        return false;
+    }
+
+    for(int i = 0; i < count; i++)
+    {
+        Source &source = *static_cast<Source *>(events[i].data.ptr);
+        if(!source.removed)
+        {
+            dispatch(source, events[i].events);
+        }
+    }
+
+    releaseRemovedSources();
+    return true;
+}
+
+void EventLoop::run()
+{
+    stop_requested_ = false;
+    while(!stop_requested_)
+    {
+        if(!runOnce(-1))
+        {
+            return;
+        }
+    }
+}
+
+void EventLoop::stop()
+{
+    stop_requested_ = true;
+    wakeup();
+}
+
+void EventLoop::wakeup()
+{
+    const uint64_t one = 1;
+    (void)!write(wakeup_fd_, &one, sizeof(one));
+}
+
+void EventLoop::dispatch(Source &source, uint32_t events)
+{
+    switch(source.type)
+    {
+    case SourceType::Interface:
+        if(events & (EPOLLIN | EPOLLERR))
+        {
+            source.iface->receiveFrames(source.iface_id, 0);
+        }
+        if(events & EPOLLOUT)
+        {
+            source.iface->flushTxQueue(source.iface_id);
+        }
+        break;
+
+    case SourceType::IoThread:
+        source.iface->serviceIoThread();
+        break;
+
+    case SourceType::PeriodicTimer:
+    case SourceType::OneShotTimer:
+    {
+        // The expiration count is discarded, a periodic timer that fell behind fires once instead of in a burst
+        uint64_t expirations = 0;
+        if(read(source.fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+        {
+            break;
+        }
+        if(source.type == SourceType::OneShotTimer)
+        {
+            cancelTimer(source.fd);
+        }
+        source.callback();
+        break;
+    }
+
+    case SourceType::Wakeup:
+    {
+        uint64_t value = 0;
+        (void)!read(source.fd, &value, sizeof(value));
+        break;
+    }
+    }
+}
+
+void EventLoop::updateTxInterest()
+{
+    // Asking for EPOLLOUT while the queue is empty or the interface is backing off would wake the loop continuously,
+    // so it is only armed on demand
+    for(auto &source : sources_)
+    {
+        if(source->type == SourceType::IoThread)
+        {
+            // Frames queued by the callbacks go to the I/O thread, which waits for writability itself
+            source->iface->flushTxToIoThread();
+            continue;
+        }
+        if(source->type != SourceType::Interface)
+        {
+            continue;
+        }
+
+        const bool pending = source->iface->txWantsWritable(source->iface_id);
+        if(pending == source->tx_armed)
+        {
+            continue;
+        }
+
+        struct epoll_event ev = {};
+        ev.events = uint32_t(EPOLLIN) | (pending ? uint32_t(EPOLLOUT) : 0U);
+        ev.data.ptr = source.get();
+        if(epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, source->fd, &ev) == 0)
+        {
+            source->tx_armed = pending;
+        }
+    }
+}
+
+void EventLoop::releaseRemovedSources()
+{
+    for(auto it = sources_.begin(); it != sources_.end();)
+    {
+        if((*it)->removed)
+        {
+            close((*it)->fd);
+            it = sources_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef EVENT_LOOP_HPP
+#define EVENT_LOOP_HPP
+
+// system includes
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class CanardInterface;
+
+/*
+  Readiness driven main loop built on epoll.
+  CAN sockets are read when they become readable and written only while frames are queued and the socket is
+  writable. Timers are backed by timerfd on CLOCK_MONOTONIC, so they have microsecond resolution and periodic
+  timers do not accumulate drift. An eventfd allows other threads to wake the loop up or stop it.
+  All callbacks run on the thread that calls run() or runOnce().
+ */
+class EventLoop {
+
+    public:
+
+        typedef std::function<void()> TimerCallback;
+
+        EventLoop() = default;
+        ~EventLoop();
+
+        EventLoop(const EventLoop&) = delete;
+        EventLoop& operator=(const EventLoop&) = delete;
+
+        /// Creates the epoll and eventfd descriptors. Returns false on error.
+        bool init();
+
+        /// Starts multiplexing the CAN sockets of all buses of the interface. The interface must outlive the loop.
+        /// If the interface runs an I/O thread, the loop waits for the thread's events instead of the sockets.
+        /// Also cleans up the stale transfers of the interface periodically.
+        bool addInterface(CanardInterface &iface);
+
+        /// Calls the callback every period_us microseconds, the first time one period from now.
+        /// Returns the timer ID, or negative on error.
+        int addPeriodicTimer(uint64_t period_us, TimerCallback callback);
+
+        /// Calls the callback once, delay_us microseconds from now. The timer is removed after it fires.
+        /// Returns the timer ID, or negative on error.
+        int addOneShotTimer(uint64_t delay_us, TimerCallback callback);
+
+        /// Removes a timer that has not expired yet. Safe to call from any callback, including the timer's own.
+        bool cancelTimer(int timer_id);
+
+        /// Waits up to timeout_ms (negative to block infinitely) and dispatches all ready events.
+        /// Returns false on error.
+        bool runOnce(int32_t timeout_ms);
+
+        /// Dispatches events until stop() is called.
+        void run();
+
+        /// Makes run() return. Safe to call from any thread.
+        void stop();
+
+        /// Interrupts a blocking wait, e.g. after another thread has queued work for the loop. Safe to call from any thread.
+        void wakeup();
+
+    private:
+
+        enum class SourceType : uint8_t {
+            Interface,
+            IoThread,
+            PeriodicTimer,
+            OneShotTimer,
+            Wakeup,
+        };
+
+        struct Source {
+            SourceType type;
+            int fd;
+            bool removed;
+            bool tx_armed;                      ///< EPOLLOUT is part of the interest set
+            CanardInterface *iface;
+            uint8_t iface_id;                   ///< Bus of the interface served by this socket
+            TimerCallback callback;
+        };
+
+        static constexpr int max_events_ = 16;
+
+        int addTimer(SourceType type, uint64_t delay_us, uint64_t period_us, TimerCallback callback);
+        void dispatch(Source &source, uint32_t events);
+        void updateTxInterest();
+        void releaseRemovedSources();
+
+        int epoll_fd_ = -1;
+        int wakeup_fd_ = -1;
+        std::atomic<bool> stop_requested_{false};
+
+        std::vector<std::unique_ptr<Source>> sources_;
+};
+
+#endif // EVENT_LOOP_HPP
@@ -0,0 +1,79 @@
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+// system includes
+#include <stddef.h>
+#include <atomic>
+
+#ifndef CANARD_INTERFACE_CACHE_LINE_SIZE
+#define CANARD_INTERFACE_CACHE_LINE_SIZE 64
+#endif
+
+/*
+  Bounded lock-free queue between exactly one producer thread and one consumer thread.
+  The consumer owns head_ and the producer owns tail_. Each index sits on its own cache line next to the owner's cached
+  copy of the other index, so the two threads only touch each other's line when that copy runs out, and the items
+  start on a separate line as well.
+  Instances must not be allocated with plain new before C++17, which does not honour the over-alignment.
+ */
+template <typename T, size_t Capacity>
+class SpscRing {
+
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+
+        /// Producer: appends a copy of the item, returns false if the ring is full
+        bool push(const T &item)
+        {
+            const size_t tail = tail_.load(std::memory_order_relaxed);
+            if(tail - cached_head_ == Capacity)
+            {
+                cached_head_ = head_.load(std::memory_order_acquire);
+                if(tail - cached_head_ == Capacity)
+                {
+                    return false;
+                }
+            }
+            items_[tail & (Capacity - 1)] = item;
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// Consumer: number of items that can be read with peek()
+        size_t readAvailable()
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            return cached_tail_ - head_.load(std::memory_order_relaxed);
+        }
+
+        /// Consumer: item at the given position from the front, which must be below readAvailable()
+        const T &peek(size_t index) const
+        {
+            return items_[(head_.load(std::memory_order_relaxed) + index) & (Capacity - 1)];
+        }
+
+        /// Consumer: releases the given number of items from the front
+        void consume(size_t count)
+        {
+            head_.store(head_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+        }
+
+        /// Either side: true if no items are queued, only a snapshot while the other side is active
+        bool empty() const
+        {
+            return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+        }
+
+    private:
+
+        alignas(CANARD_INTERFACE_CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+        size_t cached_tail_ = 0;                ///< Consumer's copy of tail_
+
+        alignas(CANARD_INTERFACE_CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+        size_t cached_head_ = 0;                ///< Producer's copy of head_
+
+        alignas(CANARD_INTERFACE_CACHE_LINE_SIZE) T items_[Capacity];
+};
+
+#endif // SPSC_RING_HPP
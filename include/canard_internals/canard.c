@@ -27,6 +27,10 @@
 #include "canard_internals.h"
 #include <string.h>
 
+#if CANARD_ENABLE_F16C
+# include <immintrin.h>
+#endif
+
 
 #undef MIN
 #undef MAX
@@ -59,6 +63,25 @@
 #define IS_END_OF_TRANSFER(x)                       ((bool)(((uint32_t)(x) >> 6U) & 0x1U))
 #define TOGGLE_BIT(x)                               ((bool)(((uint32_t)(x) >> 5U) & 0x1U))
 
+/// Number of pool blocks occupied by the RX state hash buckets at the beginning of the arena
+#define RX_STATE_TABLE_BLOCKS                                                                       \
+    ((CANARD_RX_STATE_HASH_BUCKETS * sizeof(canard_buffer_idx_t) + CANARD_RX_BLOCK_SIZE - 1U) /     \
+     CANARD_RX_BLOCK_SIZE)
+
+/// Largest pool whose block byte offsets, and block indices plus one, fit in 32 bits
+#define POOL_MAX_BLOCKS(block_size)                 (0xFFFFFFFFU / (block_size))
+
+/// RX and TX blocks come from separate pools because they differ in size
+#define POOL_SIZE_CLASSES                           (CANARD_RX_BLOCK_SIZE != CANARD_MEM_BLOCK_SIZE)
+
+#define POOL_BLOCK_AT(allocator, index)                                                             \
+    ((CanardPoolAllocatorBlock*) ((uint8_t*) (allocator)->arena + (size_t)(index) * (allocator)->block_size))
+
+#if CANARD_ENABLE_LOCKFREE_ALLOCATOR
+#define FREE_HEAD_INDEX(x)                          ((uint32_t) ((x) & 0xFFFFFFFFU))
+#define FREE_HEAD_TAG(x)                            ((uint32_t) ((x) >> 32U))
+#define MAKE_FREE_HEAD(tag, index)                  ((((uint64_t)(tag)) << 32U) | ((uint64_t)(index)))
+#endif
 
 
 /*
@@ -92,13 +115,25 @@ void canardInit(CanardInstance* out_ins,
 #if CANARD_ENABLE_TAO_OPTION
     out_ins->tao_disabled = false;
 #endif
-    size_t pool_capacity = mem_arena_size / CANARD_MEM_BLOCK_SIZE;
-    if (pool_capacity > 0xFFFFU)
+
+    // The RX state hash buckets occupy the first blocks of the arena, the remaining blocks form the pool
+    if (mem_arena_size / CANARD_RX_BLOCK_SIZE > RX_STATE_TABLE_BLOCKS)
     {
-        pool_capacity = 0xFFFFU;
+        out_ins->rx_states = (canard_buffer_idx_t*) mem_arena;
+        for (size_t i = 0; i < CANARD_RX_STATE_HASH_BUCKETS; i++)
+        {
+            out_ins->rx_states[i] = CANARD_BUFFER_IDX_NONE;
+        }
+        out_ins->pool_arena = (uint8_t*) mem_arena + RX_STATE_TABLE_BLOCKS * CANARD_RX_BLOCK_SIZE;
+        out_ins->pool_arena_size = mem_arena_size - RX_STATE_TABLE_BLOCKS * CANARD_RX_BLOCK_SIZE;
+    }
+    else
+    {
+        out_ins->pool_arena = mem_arena;
+        out_ins->pool_arena_size = 0;
     }
 
-    initPoolAllocator(&out_ins->allocator, mem_arena, (uint16_t)pool_capacity);
+    initPools(out_ins, NULL, 0);
 }
 
 void* canardGetUserReference(const CanardInstance* ins)
@@ -123,6 +158,14 @@ void canardSetLocalNodeID(CanardInstance* ins, uint8_t self_node_id)
     }
 }
 
+void canardSetRxReassemblyBuffer(CanardInstance* ins, void* buffer, uint16_t buffer_size)
+{
+    CANARD_ASSERT(ins != NULL);
+
+    ins->rx_reassembly_buffer = (uint8_t*) buffer;
+    ins->rx_reassembly_buffer_size = (buffer != NULL) ? buffer_size : 0U;
+}
+
 uint8_t canardGetLocalNodeID(const CanardInstance* ins)
 {
     return ins->node_id;
@@ -215,12 +258,13 @@ int16_t canardBroadcastObj(CanardInstance* ins, CanardTxTransfer* transfer_objec
     else
     {
         can_id = ((uint32_t) transfer_object->priority << 24U) | ((uint32_t) transfer_object->data_type_id << 8U) | (uint32_t) canardGetLocalNodeID(ins);
-        crc = calculateCRC(transfer_object);
+        crc = calculateCRC(ins, transfer_object);
     }
 
     const int16_t result = enqueueTxFrames(ins, can_id, crc, transfer_object);
 
     if (result > 0) {
+        ins->statistics.transfers_tx++;
         incrementTransferID(transfer_object->inout_transfer_id);
     }
 
@@ -285,7 +329,7 @@ CANARD_INTERNAL canard_buffer_idx_t canardRxToIdx(CanardPoolAllocator* allocator
 #endif
 }
 
-CANARD_INTERNAL uint16_t calculateCRC(const CanardTxTransfer* transfer_object)
+CANARD_INTERNAL uint16_t calculateCRC(CanardInstance* ins, const CanardTxTransfer* transfer_object)
 {
     uint16_t crc = 0xFFFFU;
 #if CANARD_ENABLE_CANFD
@@ -295,7 +339,7 @@ CANARD_INTERNAL uint16_t calculateCRC(const CanardTxTransfer* transfer_object)
     if (transfer_object->payload_len > 7)
 #endif
     {
-        crc = crcAddSignature(crc, transfer_object->data_type_signature);
+        crc = crcSignatureSeed(ins, transfer_object->data_type_signature);
         crc = crcAdd(crc, transfer_object->payload, transfer_object->payload_len);
 #if CANARD_ENABLE_CANFD
         if (transfer_object->payload_len > 63 && transfer_object->canfd) {
@@ -371,11 +415,15 @@ int16_t canardRequestOrRespondObj(CanardInstance* ins, uint8_t destination_node_
                             ((uint32_t) transfer_object->transfer_type << 15U) | ((uint32_t) destination_node_id << 8U) |
                             (1U << 7U) | (uint32_t) canardGetLocalNodeID(ins);
 
-    uint16_t crc = calculateCRC(transfer_object);
+    uint16_t crc = calculateCRC(ins, transfer_object);
 
 
     const int16_t result = enqueueTxFrames(ins, can_id, crc, transfer_object);
 
+    if (result > 0)
+    {
+        ins->statistics.transfers_tx++;
+    }
     if (result > 0 && transfer_object->transfer_type == CanardTransferTypeRequest)                      // Response Transfer ID must not be altered
     {
         incrementTransferID(transfer_object->inout_transfer_id);
@@ -393,22 +441,184 @@ CanardCANFrame* canardPeekTxQueue(const CanardInstance* ins)
     return &ins->tx_queue->frame;
 }
 
-void canardPopTxQueue(CanardInstance* ins)
+uint16_t canardPeekTxQueueFrames(const CanardInstance* ins, const CanardCANFrame** out_frames, uint16_t max_frames)
+{
+    uint16_t count = 0;
+    for (const CanardTxQueueItem* item = ins->tx_queue; (item != NULL) && (count < max_frames); item = item->next)
+    {
+        out_frames[count++] = &item->frame;
+    }
+    return count;
+}
+
+#if CANARD_MULTI_IFACE
+uint16_t canardPeekTxQueueFramesForIface(const CanardInstance* ins,
+                                         uint8_t iface_id,
+                                         const CanardCANFrame** out_frames,
+                                         uint16_t max_frames)
+{
+    const uint8_t iface_bit = (uint8_t)(1U << iface_id);
+    uint16_t count = 0;
+    for (const CanardTxQueueItem* item = ins->tx_queue; (item != NULL) && (count < max_frames); item = item->next)
+    {
+        if ((item->frame.iface_mask & iface_bit) != 0)
+        {
+            out_frames[count++] = &item->frame;
+        }
+    }
+    return count;
+}
+
+void canardPopTxQueueFramesForIface(CanardInstance* ins, uint8_t iface_id, uint16_t frame_count)
+{
+    canardRemoveTxQueueFramesForIface(ins, iface_id, frame_count, CanardTxFrameTransmitted);
+}
+
+void canardRemoveTxQueueFramesForIface(CanardInstance* ins,
+                                       uint8_t iface_id,
+                                       uint16_t frame_count,
+                                       CanardTxFrameOutcome outcome)
 {
+    const uint8_t iface_bit = (uint8_t)(1U << iface_id);
+    const uint16_t requested_count = frame_count;
+    CanardTxQueueItem* previous = NULL;
     CanardTxQueueItem* item = ins->tx_queue;
-    ins->tx_queue = item->next;
-    freeBlock(&ins->allocator, item);
+    while ((item != NULL) && (frame_count > 0))
+    {
+        CanardTxQueueItem* const next_item = item->next;
+        if ((item->frame.iface_mask & iface_bit) != 0)
+        {
+            frame_count--;
+            item->frame.iface_mask &= (uint8_t)~iface_bit;
+            if (item->frame.iface_mask == 0)
+            {
+                removeTxQueueItem(ins, previous, item);
+                item = next_item;
+                continue;
+            }
+        }
+        previous = item;
+        item = next_item;
+    }
+    countTxFrames(ins, iface_id, (uint16_t)(requested_count - frame_count), outcome);
+}
+#endif
+
+uint32_t canardGetTxQueueLength(const CanardInstance* ins)
+{
+    return ins->tx_queue_length;
+}
+
+void canardPopTxQueue(CanardInstance* ins)
+{
+    canardRemoveTxQueueFrame(ins, CanardTxFrameTransmitted);
+}
+
+void canardRemoveTxQueueFrame(CanardInstance* ins, CanardTxFrameOutcome outcome)
+{
+#if CANARD_MULTI_IFACE
+    // Counted on every interface it was meant for
+    for (uint8_t iface_id = 0; iface_id < 8U; iface_id++)
+    {
+        if ((ins->tx_queue->frame.iface_mask & (1U << iface_id)) != 0)
+        {
+            countTxFrames(ins, iface_id, 1, outcome);
+        }
+    }
+#else
+    countTxFrames(ins, 0, 1, outcome);
+#endif
+    removeTxQueueItem(ins, NULL, ins->tx_queue);
+}
+
+CanardTransportStatistics canardGetTransportStatistics(const CanardInstance* ins)
+{
+    return ins->statistics;
+}
+
+CANARD_INTERNAL void countRxFrame(CanardInstance* ins, uint8_t iface_id, int16_t result)
+{
+    CanardTransportStatistics* const statistics = &ins->statistics;
+    statistics->frames_rx++;
+
+    bool transfer_error = false;
+    if (result == -CANARD_ERROR_OUT_OF_MEMORY)
+    {
+        statistics->rx_out_of_memory++;
+        transfer_error = true;
+    }
+    else if ((result <= -CANARD_ERROR_RX_INCOMPATIBLE_PACKET) && (result >= -CANARD_ERROR_RX_BAD_CRC))
+    {
+        statistics->rx_errors[-result - CANARD_ERROR_RX_INCOMPATIBLE_PACKET]++;
+        transfer_error = (result <= -CANARD_ERROR_RX_MISSED_START);
+    }
+    else
+    {
+        // Accepted frame
+    }
+
+    if (transfer_error)
+    {
+        statistics->transfer_errors++;
+    }
+    if (iface_id < CANARD_STATISTICS_MAX_IFACES)
+    {
+        statistics->iface[iface_id].frames_rx++;
+        if (transfer_error)
+        {
+            statistics->iface[iface_id].errors++;
+        }
+    }
+}
+
+CANARD_INTERNAL void countTxFrames(CanardInstance* ins,
+                                   uint8_t iface_id,
+                                   uint16_t frame_count,
+                                   CanardTxFrameOutcome outcome)
+{
+    CanardIfaceStatistics* const iface =
+        (iface_id < CANARD_STATISTICS_MAX_IFACES) ? &ins->statistics.iface[iface_id] : NULL;
+
+    if (outcome == CanardTxFrameTransmitted)
+    {
+        ins->statistics.frames_tx += frame_count;
+        if (iface != NULL)
+        {
+            iface->frames_tx += frame_count;
+        }
+    }
+    else if (outcome == CanardTxFrameDropped)
+    {
+        ins->statistics.tx_dropped += frame_count;
+        if (iface != NULL)
+        {
+            iface->errors += frame_count;
+        }
+    }
+    else
+    {
+        // Handed off, counted by the caller once the outcome is known
+    }
 }
 
 int16_t canardHandleRxFrame(CanardInstance* ins, const CanardCANFrame* frame, uint64_t timestamp_usec)
+{
+    const int16_t result = handleRxFrame(ins, frame, timestamp_usec);
+#if CANARD_MULTI_IFACE
+    countRxFrame(ins, frame->iface_id, result);
+#else
+    countRxFrame(ins, 0, result);
+#endif
+    return result;
+}
+
+CANARD_INTERNAL int16_t handleRxFrame(CanardInstance* ins, const CanardCANFrame* frame, uint64_t timestamp_usec)
 {
     const CanardTransferType transfer_type = extractTransferType(frame->id);
     const uint8_t destination_node_id = (transfer_type == CanardTransferTypeBroadcast) ?
                                         (uint8_t)CANARD_BROADCAST_NODE_ID :
                                         DEST_ID_FROM_ID(frame->id);
 
-    // TODO: This function should maintain statistics of transfer errors and such.
-
     if ((frame->id & CANARD_CAN_FRAME_EFF) == 0 ||
         (frame->id & CANARD_CAN_FRAME_RTR) != 0 ||
         (frame->id & CANARD_CAN_FRAME_ERR) != 0 ||
@@ -519,6 +729,7 @@ int16_t canardHandleRxFrame(CanardInstance* ins, const CanardCANFrame* frame, ui
 #endif
         };
 
+        ins->statistics.transfers_rx++;
         ins->on_reception(ins, &rx_transfer);
 
         prepareForNextTransfer(rx_state);
@@ -554,7 +765,7 @@ int16_t canardHandleRxFrame(CanardInstance* ins, const CanardCANFrame* frame, ui
             return -CANARD_ERROR_OUT_OF_MEMORY;
         }
         rx_state->payload_crc = (uint16_t)(((uint16_t) frame->data[0]) | (uint16_t)((uint16_t) frame->data[1] << 8U));
-        rx_state->calculated_crc = crcAddSignature(0xFFFFU, data_type_signature);
+        rx_state->calculated_crc = crcSignatureSeed(ins, data_type_signature);
         rx_state->calculated_crc = crcAdd((uint16_t)rx_state->calculated_crc,
                                           frame->data + 2, (uint8_t)(frame->data_len - 3));
     }
@@ -575,49 +786,12 @@ int16_t canardHandleRxFrame(CanardInstance* ins, const CanardCANFrame* frame, ui
     {
         const uint8_t frame_payload_size = (uint8_t)(frame->data_len - 1);
 
-        uint8_t tail_offset = 0;
-
-        if (rx_state->payload_len < CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE)
-        {
-            // Copy the beginning of the frame into the head, point the tail pointer to the remainder
-            for (size_t i = rx_state->payload_len;
-                 (i < CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE) && (tail_offset < frame_payload_size);
-                 i++, tail_offset++)
-            {
-                rx_state->buffer_head[i] = frame->data[tail_offset];
-            }
-        }
-        else
-        {
-            // Like above, except that the beginning goes into the last block of the storage
-            CanardBufferBlock* block = canardBufferFromIdx(&ins->allocator, rx_state->buffer_blocks);
-            if (block != NULL)
-            {
-                size_t offset = CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE;    // Payload offset of the first block
-                while (block->next != NULL)
-                {
-                    block = block->next;
-                    offset += CANARD_BUFFER_BLOCK_DATA_SIZE;
-                }
-                CANARD_ASSERT(block != NULL);
-
-                const size_t offset_within_block = rx_state->payload_len - offset;
-                CANARD_ASSERT(offset_within_block <= CANARD_BUFFER_BLOCK_DATA_SIZE);
-
-                for (size_t i = offset_within_block;
-                     (i < CANARD_BUFFER_BLOCK_DATA_SIZE) && (tail_offset < frame_payload_size);
-                     i++, tail_offset++)
-                {
-                    block->data[i] = frame->data[tail_offset];
-                }
-            }
-        }
+        // CRC validation
+        rx_state->calculated_crc = crcAdd((uint16_t)rx_state->calculated_crc, frame->data, frame_payload_size);
+        const bool crc_ok = (rx_state->calculated_crc == rx_state->payload_crc);
 
         CanardRxTransfer rx_transfer = {
             .timestamp_usec = timestamp_usec,
-            .payload_head = rx_state->buffer_head,
-            .payload_middle = canardBufferFromIdx(&ins->allocator, rx_state->buffer_blocks),
-            .payload_tail = (tail_offset >= frame_payload_size) ? NULL : (&frame->data[tail_offset]),
             .payload_len = (uint16_t)(rx_state->payload_len + frame_payload_size),
             .data_type_id = data_type_id,
             .transfer_type = (uint8_t)transfer_type,
@@ -633,12 +807,55 @@ int16_t canardHandleRxFrame(CanardInstance* ins, const CanardCANFrame* frame, ui
 #endif
         };
 
-        rx_state->buffer_blocks = CANARD_BUFFER_IDX_NONE;     // Block list ownership has been transferred to rx_transfer!
+        if (crc_ok && (rx_transfer.payload_len <= ins->rx_reassembly_buffer_size))
+        {
+            // Contiguous delivery: the transfer looks like a single-frame one to the application
+            gatherStatePayload(&ins->allocator, rx_state, frame->data, frame_payload_size, ins->rx_reassembly_buffer);
+            releaseStatePayload(ins, rx_state);
+            rx_transfer.payload_head = ins->rx_reassembly_buffer;
+        }
+        else
+        {
+            uint8_t tail_offset = 0;
+
+            if (rx_state->payload_len < CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE)
+            {
+                // Copy the beginning of the frame into the head, point the tail pointer to the remainder
+                for (size_t i = rx_state->payload_len;
+                     (i < CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE) && (tail_offset < frame_payload_size);
+                     i++, tail_offset++)
+                {
+                    rx_state->buffer_head[i] = frame->data[tail_offset];
+                }
+            }
+            else
+            {
+                // Like above, except that the beginning goes into the last block of the storage
+                CanardBufferBlock* block = canardBufferFromIdx(&ins->allocator, rx_state->buffer_blocks);
+                if (block != NULL)
+                {
+                    const size_t offset_within_block = lastBufferBlockFill(rx_state);
+                    CANARD_ASSERT(offset_within_block <= CANARD_BUFFER_BLOCK_DATA_SIZE);
+
+                    for (size_t i = offset_within_block;
+                         (i < CANARD_BUFFER_BLOCK_DATA_SIZE) && (tail_offset < frame_payload_size);
+                         i++, tail_offset++)
+                    {
+                        block->data[i] = frame->data[tail_offset];
+                    }
+                }
+            }
+
+            rx_transfer.payload_head = rx_state->buffer_head;
+            rx_transfer.payload_middle = detachBufferBlocks(&ins->allocator, rx_state);
+            rx_transfer.payload_tail = (tail_offset >= frame_payload_size) ? NULL : (&frame->data[tail_offset]);
+        }
 
-        // CRC validation
-        rx_state->calculated_crc = crcAdd((uint16_t)rx_state->calculated_crc, frame->data, frame->data_len - 1U);
-        if (rx_state->calculated_crc == rx_state->payload_crc)
+        CANARD_ASSERT(rx_state->buffer_blocks == CANARD_BUFFER_IDX_NONE);  // Ownership was transferred to rx_transfer!
+
+        if (crc_ok)
         {
+            ins->statistics.transfers_rx++;
             ins->on_reception(ins, &rx_transfer);
         }
 
@@ -646,7 +863,7 @@ int16_t canardHandleRxFrame(CanardInstance* ins, const CanardCANFrame* frame, ui
         canardReleaseRxTransferPayload(ins, &rx_transfer);
         prepareForNextTransfer(rx_state);
 
-        if (rx_state->calculated_crc == rx_state->payload_crc)
+        if (crc_ok)
         {
             return CANARD_OK;
         }
@@ -660,42 +877,32 @@ int16_t canardHandleRxFrame(CanardInstance* ins, const CanardCANFrame* frame, ui
     return CANARD_OK;
 }
 
-void canardCleanupStaleTransfers(CanardInstance* ins, uint64_t current_time_usec)
+uint16_t canardHandleRxFrames(CanardInstance* ins,
+                              const CanardCANFrame* frames,
+                              const uint64_t* timestamps_usec,
+                              uint16_t frame_count)
 {
-    CanardRxState* prev = ins->rx_states, * state = ins->rx_states;
-
-    while (state != NULL)
+    uint16_t processed = 0;
+    for (uint16_t i = 0; i < frame_count; i++)
     {
-        if ((current_time_usec - state->timestamp_usec) > TRANSFER_TIMEOUT_USEC)
-        {
-            if (state == ins->rx_states)
-            {
-                releaseStatePayload(ins, state);
-                ins->rx_states = canardRxFromIdx(&ins->allocator, ins->rx_states->next);
-                freeBlock(&ins->allocator, state);
-                state = ins->rx_states;
-                prev = state;
-            }
-            else
-            {
-                releaseStatePayload(ins, state);
-                prev->next = state->next;
-                freeBlock(&ins->allocator, state);
-                state = canardRxFromIdx(&ins->allocator, prev->next);
-            }
-        }
-        else
+        if (canardHandleRxFrame(ins, &frames[i], timestamps_usec[i]) >= 0)
         {
-            prev = state;
-            state = canardRxFromIdx(&ins->allocator, state->next);
+            processed++;
         }
     }
+    return processed;
+}
+
+void canardCleanupStaleTransfers(CanardInstance* ins, uint64_t current_time_usec)
+{
+    expireRxStates(ins, current_time_usec);
 
 #if CANARD_MULTI_IFACE || CANARD_ENABLE_DEADLINE
     // remove stale TX transfers
-    CanardTxQueueItem* prev_item = ins->tx_queue, * item = ins->tx_queue;
+    CanardTxQueueItem* prev_item = NULL, * item = ins->tx_queue;
     while (item != NULL)
     {
+        CanardTxQueueItem* const next_item = item->next;
 #if CANARD_MULTI_IFACE && CANARD_ENABLE_DEADLINE
         if ((current_time_usec > item->frame.deadline_usec) || item->frame.iface_mask == 0)
 #elif CANARD_MULTI_IFACE
@@ -704,25 +911,13 @@ void canardCleanupStaleTransfers(CanardInstance* ins, uint64_t current_time_usec
         if (current_time_usec > item->frame.deadline_usec)
 #endif
         {
-            if (item == ins->tx_queue)
-            {
-                ins->tx_queue = ins->tx_queue->next;
-                freeBlock(&ins->allocator, item);
-                item = ins->tx_queue;
-                prev_item = item;
-            }
-            else
-            {
-                prev_item->next = item->next;
-                freeBlock(&ins->allocator, item);
-                item = prev_item->next;
-            }
+            removeTxQueueItem(ins, prev_item, item);
         }
         else
         {
             prev_item = item;
-            item = item->next;
         }
+        item = next_item;
     }
 #endif
 }
@@ -748,6 +943,22 @@ int16_t canardDecodeScalar(const CanardRxTransfer* transfer,
         return -CANARD_ERROR_INVALID_ARGUMENT;
     }
 
+#if CANARD_ENABLE_FAST_SCALAR_CODEC
+    {
+        // Single-frame and contiguously reassembled transfers have the whole payload behind the head pointer;
+        // otherwise only the head part is contiguous.
+        const uint32_t contiguous_len = ((transfer->payload_middle == NULL) && (transfer->payload_tail == NULL)) ?
+                                        transfer->payload_len :
+                                        MIN(transfer->payload_len, CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE);
+
+        if (((bit_offset + bit_length) <= (contiguous_len * 8U)) && (((bit_offset % 8U) + bit_length) <= 64U))
+        {
+            decodeContiguousScalar(transfer->payload_head, bit_offset, bit_length, value_is_signed, out_value);
+            return bit_length;
+        }
+    }
+#endif
+
     /*
      * Reading raw bytes into the temporary storage.
      * Luckily, C guarantees that every element is aligned at the beginning (lower address) of the union.
@@ -927,6 +1138,14 @@ void canardEncodeScalar(void* destination,
         bit_length = 1;
     }
 
+#if CANARD_ENABLE_FAST_SCALAR_CODEC
+    if (((bit_offset % 8U) + bit_length) <= 64U)
+    {
+        encodeContiguousScalar((uint8_t*) destination, bit_offset, bit_length, value);
+        return;
+    }
+#endif
+
     /*
      * Preparing the data in the temporary storage.
      */
@@ -1011,7 +1230,37 @@ void canardReleaseRxTransferPayload(CanardInstance* ins, CanardRxTransfer* trans
 
 CanardPoolAllocatorStatistics canardGetPoolAllocatorStatistics(CanardInstance* ins)
 {
-    return ins->allocator.statistics;
+    return readPoolAllocatorStatistics(&ins->allocator);
+}
+
+int16_t canardSetTxArena(CanardInstance* ins,
+                         void* mem_arena,
+                         size_t mem_arena_size)
+{
+    CANARD_ASSERT(ins != NULL);
+
+    // Queued items have to be returned to the pool they came from
+    if (ins->tx_queue != NULL)
+    {
+        return -CANARD_ERROR_INVALID_ARGUMENT;
+    }
+
+#if POOL_SIZE_CLASSES
+    // The TX share of the canardInit() arena is given to the RX pool or taken back from it
+    if (readPoolAllocatorStatistics(&ins->allocator).current_usage_blocks != 0U)
+    {
+        return -CANARD_ERROR_INVALID_ARGUMENT;
+    }
+    initPools(ins, mem_arena, mem_arena_size);
+#else
+    initTxPool(ins, mem_arena, mem_arena_size);
+#endif
+    return CANARD_OK;
+}
+
+CanardPoolAllocatorStatistics canardGetTxPoolAllocatorStatistics(CanardInstance* ins)
+{
+    return readPoolAllocatorStatistics(txAllocator(ins));
 }
 
 uint16_t canardConvertNativeFloatToFloat16(float value)
@@ -1083,6 +1332,38 @@ float canardConvertFloat16ToNativeFloat(uint16_t value)
     return out.f;
 }
 
+void canardConvertFloat16ArrayToNativeFloat(const uint16_t* values, float* out_values, size_t count)
+{
+    size_t i = 0;
+#if CANARD_ENABLE_F16C
+    if (hasHardwareFloat16())
+    {
+        i = count & ~(size_t)7U;
+        convertFloat16ArrayToNativeFloatF16C(values, out_values, i);
+    }
+#endif
+    for (; i < count; i++)
+    {
+        out_values[i] = canardConvertFloat16ToNativeFloat(values[i]);
+    }
+}
+
+void canardConvertNativeFloatArrayToFloat16(const float* values, uint16_t* out_values, size_t count)
+{
+    size_t i = 0;
+#if CANARD_ENABLE_F16C
+    if (hasHardwareFloat16())
+    {
+        i = count & ~(size_t)7U;
+        convertNativeFloatArrayToFloat16F16C(values, out_values, i);
+    }
+#endif
+    for (; i < count; i++)
+    {
+        out_values[i] = canardConvertNativeFloatToFloat16(values[i]);
+    }
+}
+
 /*
  * Internal (static functions)
  */
@@ -1176,7 +1457,7 @@ CANARD_INTERNAL int16_t enqueueTxFrames(CanardInstance* ins,
 #endif
     if (transfer->payload_len < frame_max_data_len)                        // Single frame transfer
     {
-        CanardTxQueueItem* queue_item = createTxItem(&ins->allocator);
+        CanardTxQueueItem* queue_item = createTxItem(txAllocator(ins));
         if (queue_item == NULL)
         {
             return -CANARD_ERROR_OUT_OF_MEMORY;
@@ -1215,7 +1496,8 @@ CANARD_INTERNAL int16_t enqueueTxFrames(CanardInstance* ins,
         const uint16_t total_bytes = transfer->payload_len + 2; // including CRC
         const uint8_t bytes_per_frame = frame_max_data_len-1; // sot/eot byte consumes one byte
         const uint16_t frames_needed = (total_bytes + (bytes_per_frame-1)) / bytes_per_frame;
-        const uint16_t blocks_available = ins->allocator.statistics.capacity_blocks - ins->allocator.statistics.current_usage_blocks;
+        const CanardPoolAllocatorStatistics statistics = readPoolAllocatorStatistics(txAllocator(ins));
+        const uint32_t blocks_available = statistics.capacity_blocks - statistics.current_usage_blocks;
         if (blocks_available < frames_needed) {
             return -CANARD_ERROR_OUT_OF_MEMORY;
         }
@@ -1224,7 +1506,7 @@ CANARD_INTERNAL int16_t enqueueTxFrames(CanardInstance* ins,
 
         while (transfer->payload_len - data_index != 0)
         {
-            queue_item = createTxItem(&ins->allocator);
+            queue_item = createTxItem(txAllocator(ins));
             if (queue_item == NULL)
             {
                 CANARD_ASSERT(false);
@@ -1277,80 +1559,143 @@ CANARD_INTERNAL int16_t enqueueTxFrames(CanardInstance* ins,
 
 /**
  * Puts frame on on the TX queue. Higher priority placed first
+ *
+ * The queue is a single list ordered by CAN ID. The last frame of every priority level is tracked, so a frame
+ * that doesn't win arbitration against the frames already queued at its level is appended in constant time.
  */
 CANARD_INTERNAL void pushTxQueue(CanardInstance* ins, CanardTxQueueItem* item)
 {
     CANARD_ASSERT(ins != NULL);
     CANARD_ASSERT(item->frame.data_len > 0);       // UAVCAN doesn't allow zero-payload frames
 
-    if (ins->tx_queue == NULL)
+    const uint8_t level = PRIORITY_FROM_ID(item->frame.id);
+    CanardTxQueueItem* const tail = ins->tx_queue_tails[level];
+
+    ins->tx_queue_length++;
+
+    if (tail != NULL && !isPriorityHigher(tail->frame.id, item->frame.id))
     {
-        ins->tx_queue = item;
+        item->next = tail->next;
+        tail->next = item;
+        ins->tx_queue_tails[level] = item;
         return;
     }
 
-    CanardTxQueueItem* queue = ins->tx_queue;
-    CanardTxQueueItem* previous = ins->tx_queue;
+    // The level begins right after the last frame of the closest non-empty higher priority level
+    CanardTxQueueItem* previous = NULL;
+    const uint32_t higher_levels = ins->tx_queue_levels & ((1UL << level) - 1U);
+    if (higher_levels != 0)
+    {
+        previous = ins->tx_queue_tails[highestSetBit(higher_levels)];
+    }
 
-    while (queue != NULL)
+    if (tail == NULL)
     {
-        if (isPriorityHigher(queue->frame.id, item->frame.id)) // lower number wins
-        {
-            if (queue == ins->tx_queue)
-            {
-                item->next = queue;
-                ins->tx_queue = item;
-            }
-            else
-            {
-                previous->next = item;
-                item->next = queue;
-            }
-            return;
-        }
-        else
+        ins->tx_queue_tails[level] = item;
+        ins->tx_queue_levels |= 1UL << level;
+    }
+    else
+    {
+        // The frame wins arbitration against the last frame of its level, so it has to be inserted inside the level
+        CanardTxQueueItem* queue = (previous == NULL) ? ins->tx_queue : previous->next;
+        while (!isPriorityHigher(queue->frame.id, item->frame.id))
         {
-            if (queue->next == NULL)
-            {
-                queue->next = item;
-                return;
-            }
-            else
-            {
-                previous = queue;
-                queue = queue->next;
-            }
+            previous = queue;
+            queue = queue->next;
         }
     }
-}
 
-/**
- * Creates new tx queue item from allocator
- */
-CANARD_INTERNAL CanardTxQueueItem* createTxItem(CanardPoolAllocator* allocator)
-{
-    CanardTxQueueItem* item = (CanardTxQueueItem*) allocateBlock(allocator);
-    if (item == NULL)
+    if (previous == NULL)
     {
-        return NULL;
+        item->next = ins->tx_queue;
+        ins->tx_queue = item;
+    }
+    else
+    {
+        item->next = previous->next;
+        previous->next = item;
     }
-    memset(item, 0, sizeof(*item));
-    return item;
 }
 
 /**
- * Returns true if priority of rhs is higher than id
+ * Unlinks the frame from the TX queue and frees it. Previous is the frame in front of it, or NULL for the first one
  */
-CANARD_INTERNAL bool isPriorityHigher(uint32_t rhs, uint32_t id)
+CANARD_INTERNAL void removeTxQueueItem(CanardInstance* ins, CanardTxQueueItem* previous, CanardTxQueueItem* item)
 {
-    const uint32_t clean_id = id & CANARD_CAN_EXT_ID_MASK;
-    const uint32_t rhs_clean_id = rhs & CANARD_CAN_EXT_ID_MASK;
+    CANARD_ASSERT(item != NULL);
+    CANARD_ASSERT((previous == NULL) ? (ins->tx_queue == item) : (previous->next == item));
 
-    /*
-     * STD vs EXT - if 11 most significant bits are the same, EXT loses.
-     */
-    const bool ext = (id & CANARD_CAN_FRAME_EFF) != 0;
-    const bool rhs_ext = (rhs & CANARD_CAN_FRAME_EFF) != 0;
+    const uint8_t level = PRIORITY_FROM_ID(item->frame.id);
+    if (ins->tx_queue_tails[level] == item)
+    {
+        if (previous != NULL && PRIORITY_FROM_ID(previous->frame.id) == level)
+        {
+            ins->tx_queue_tails[level] = previous;
+        }
+        else
+        {
+            ins->tx_queue_tails[level] = NULL;
+            ins->tx_queue_levels &= ~(1UL << level);
+        }
+    }
+
+    if (previous == NULL)
+    {
+        ins->tx_queue = item->next;
+    }
+    else
+    {
+        previous->next = item->next;
+    }
+    ins->tx_queue_length--;
+    freeBlock(txAllocator(ins), item);
+}
+
+/**
+ * Returns the index of the most significant set bit, the argument must not be zero
+ */
+CANARD_INTERNAL uint8_t highestSetBit(uint32_t value)
+{
+    CANARD_ASSERT(value != 0);
+#if defined(__GNUC__)
+    return (uint8_t)(31U - (uint32_t)__builtin_clz(value));
+#else
+    uint8_t bit = 0;
+    while ((value >>= 1U) != 0)
+    {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+/**
+ * Creates new tx queue item from allocator
+ */
+CANARD_INTERNAL CanardTxQueueItem* createTxItem(CanardPoolAllocator* allocator)
+{
+    CanardTxQueueItem* item = (CanardTxQueueItem*) allocateBlock(allocator);
+    if (item == NULL)
+    {
+        return NULL;
+    }
+    memset(item, 0, sizeof(*item));
+    return item;
+}
+
+/**
+ * Returns true if priority of rhs is higher than id
+ */
+CANARD_INTERNAL bool isPriorityHigher(uint32_t rhs, uint32_t id)
+{
+    const uint32_t clean_id = id & CANARD_CAN_EXT_ID_MASK;
+    const uint32_t rhs_clean_id = rhs & CANARD_CAN_EXT_ID_MASK;
+
+    /*
+     * STD vs EXT - if 11 most significant bits are the same, EXT loses.
+     */
+    const bool ext = (id & CANARD_CAN_FRAME_EFF) != 0;
+    const bool rhs_ext = (rhs & CANARD_CAN_FRAME_EFF) != 0;
     if (ext != rhs_ext)
     {
         uint32_t arb11 = ext ? (clean_id >> 18U) : clean_id;
@@ -1437,30 +1782,31 @@ CanardTransferType extractTransferType(uint32_t id)
  */
 
 /**
- * Traverses the list of CanardRxState's and returns a pointer to the CanardRxState
- * with either the Id or a new one at the end
+ * Returns the index of the hash bucket that holds the RX state of the transfer descriptor
  */
-CANARD_INTERNAL CanardRxState* traverseRxStates(CanardInstance* ins, uint32_t transfer_descriptor)
+CANARD_INTERNAL uint32_t rxStateBucket(uint32_t transfer_descriptor)
 {
-    CanardRxState* states = ins->rx_states;
+    // Fibonacci hashing: only the top bits of the 32-bit product depend on every bit of the descriptor, so those select
+    // the bucket. Multiplying by the power of two bucket count and keeping the upper word takes exactly those bits.
+    const uint32_t hash = (uint32_t)(transfer_descriptor * 2654435761UL);
+    return (uint32_t)(((uint64_t)hash * CANARD_RX_STATE_HASH_BUCKETS) >> 32U);
+}
 
-    if (states == NULL) // initialize CanardRxStates
+/**
+ * Looks up the CanardRxState of the transfer descriptor and returns a pointer to it,
+ * or creates a new one if it doesn't exist yet
+ */
+CANARD_INTERNAL CanardRxState* traverseRxStates(CanardInstance* ins, uint32_t transfer_descriptor)
+{
+    if (ins->rx_states == NULL)
     {
-        states = createRxState(&ins->allocator, transfer_descriptor);
-
-        if(states == NULL)
-        {
-            return NULL;
-        }
-
-        ins->rx_states = states;
-        return states;
+        return NULL;
     }
 
-    states = findRxState(ins, transfer_descriptor);
-    if (states != NULL)
+    CanardRxState* state = findRxState(ins, transfer_descriptor);
+    if (state != NULL)
     {
-        return states;
+        return state;
     }
     else
     {
@@ -1473,7 +1819,12 @@ CANARD_INTERNAL CanardRxState* traverseRxStates(CanardInstance* ins, uint32_t tr
  */
 CANARD_INTERNAL CanardRxState* findRxState(CanardInstance *ins, uint32_t transfer_descriptor)
 {
-    CanardRxState *state = ins->rx_states;
+    if (ins->rx_states == NULL)
+    {
+        return NULL;
+    }
+
+    CanardRxState *state = canardRxFromIdx(&ins->allocator, ins->rx_states[rxStateBucket(transfer_descriptor)]);
     while (state != NULL)
     {
         if (state->dtid_tt_snid_dnid == transfer_descriptor)
@@ -1486,7 +1837,7 @@ CANARD_INTERNAL CanardRxState* findRxState(CanardInstance *ins, uint32_t transfe
 }
 
 /**
- * prepends rx state to the canard instance rx_states
+ * prepends rx state to the hash bucket of its transfer descriptor
  */
 CANARD_INTERNAL CanardRxState* prependRxState(CanardInstance* ins, uint32_t transfer_descriptor)
 {
@@ -1497,11 +1848,96 @@ CANARD_INTERNAL CanardRxState* prependRxState(CanardInstance* ins, uint32_t tran
         return NULL;
     }
 
-    state->next = canardRxToIdx(&ins->allocator, ins->rx_states);
-    ins->rx_states = state;
+    canard_buffer_idx_t* const bucket = &ins->rx_states[rxStateBucket(transfer_descriptor)];
+    state->next = *bucket;
+    *bucket = canardRxToIdx(&ins->allocator, state);
+
+    // The timestamp is still zero, so the state is looked at again on the next tick, after its first frame
+    scheduleRxState(ins, state);
     return state;
 }
 
+CANARD_INTERNAL void scheduleRxState(CanardInstance* ins, CanardRxState* state)
+{
+    uint64_t expiry_usec = state->timestamp_usec + TRANSFER_TIMEOUT_USEC;
+    if (expiry_usec < ins->rx_timer_wheel_usec)
+    {
+        expiry_usec = ins->rx_timer_wheel_usec;
+    }
+    const size_t slot = (size_t)((expiry_usec / CANARD_RX_TIMER_WHEEL_TICK_USEC) & (CANARD_RX_TIMER_WHEEL_SLOTS - 1U));
+
+    // Expiry times more than one revolution ahead wrap around; such states are rescheduled when their slot comes up
+    const uint32_t index = (uint32_t)(((uint8_t*) state - (uint8_t*) ins->allocator.arena) / CANARD_RX_BLOCK_SIZE);
+    ins->rx_timer_wheel_links[index] = ins->rx_timer_wheel[slot];
+    ins->rx_timer_wheel[slot] = index + 1U;
+}
+
+CANARD_INTERNAL void expireRxStates(CanardInstance* ins, uint64_t current_time_usec)
+{
+    if ((ins->rx_states == NULL) || (current_time_usec < ins->rx_timer_wheel_usec))
+    {
+        return;
+    }
+
+    // A slot is processed once its whole period has elapsed. After a long pause every slot is visited once, and the
+    // wheel then jumps to the current time.
+    uint64_t ticks = (current_time_usec - ins->rx_timer_wheel_usec) / CANARD_RX_TIMER_WHEEL_TICK_USEC;
+    const bool jump = ticks > CANARD_RX_TIMER_WHEEL_SLOTS;
+    if (jump)
+    {
+        ticks = CANARD_RX_TIMER_WHEEL_SLOTS;
+    }
+
+    for (uint64_t tick = 0; tick < ticks; tick++)
+    {
+        const size_t slot = (size_t)((ins->rx_timer_wheel_usec / CANARD_RX_TIMER_WHEEL_TICK_USEC) &
+                                     (CANARD_RX_TIMER_WHEEL_SLOTS - 1U));
+        uint32_t index = ins->rx_timer_wheel[slot];
+        ins->rx_timer_wheel[slot] = 0;
+
+        // Advanced first, so that states that are not due yet are rescheduled into a later slot, not this one
+        ins->rx_timer_wheel_usec += CANARD_RX_TIMER_WHEEL_TICK_USEC;
+
+        while (index != 0)
+        {
+            CanardRxState* const state =
+                (CanardRxState*) ((uint8_t*) ins->allocator.arena + (size_t)(index - 1U) * CANARD_RX_BLOCK_SIZE);
+            index = ins->rx_timer_wheel_links[index - 1U];
+
+            if ((current_time_usec - state->timestamp_usec) > TRANSFER_TIMEOUT_USEC)
+            {
+                removeRxState(ins, state);
+            }
+            else
+            {
+                // Updated by a newer transfer since it was scheduled
+                scheduleRxState(ins, state);
+            }
+        }
+    }
+
+    if (jump)
+    {
+        ins->rx_timer_wheel_usec = current_time_usec - (current_time_usec % CANARD_RX_TIMER_WHEEL_TICK_USEC);
+    }
+}
+
+CANARD_INTERNAL void removeRxState(CanardInstance* ins, CanardRxState* state)
+{
+    canard_buffer_idx_t* link = &ins->rx_states[rxStateBucket(state->dtid_tt_snid_dnid)];
+    CanardRxState* current = canardRxFromIdx(&ins->allocator, *link);
+    while (current != state)
+    {
+        CANARD_ASSERT(current != NULL);
+        link = &current->next;
+        current = canardRxFromIdx(&ins->allocator, *link);
+    }
+
+    *link = state->next;
+    releaseStatePayload(ins, state);
+    freeBlock(&ins->allocator, state);
+}
+
 CANARD_INTERNAL CanardRxState* createRxState(CanardPoolAllocator* allocator, uint32_t transfer_descriptor)
 {
     CanardRxState init = {
@@ -1522,12 +1958,12 @@ CANARD_INTERNAL CanardRxState* createRxState(CanardPoolAllocator* allocator, uin
 
 CANARD_INTERNAL uint64_t releaseStatePayload(CanardInstance* ins, CanardRxState* rxstate)
 {
-    while (rxstate->buffer_blocks != CANARD_BUFFER_IDX_NONE)
+    CanardBufferBlock* block = detachBufferBlocks(&ins->allocator, rxstate);
+    while (block != NULL)
     {
-        CanardBufferBlock* block = canardBufferFromIdx(&ins->allocator, rxstate->buffer_blocks);
         CanardBufferBlock* const temp = block->next;
         freeBlock(&ins->allocator, block);
-        rxstate->buffer_blocks = canardBufferToIdx(&ins->allocator, temp);
+        block = temp;
     }
     rxstate->payload_len = 0;
     return CANARD_OK;
@@ -1535,6 +1971,10 @@ CANARD_INTERNAL uint64_t releaseStatePayload(CanardInstance* ins, CanardRxState*
 
 /*
  *  CanardBufferBlock functions
+ *
+ *  While a transfer is being reassembled, CanardRxState.buffer_blocks refers to the LAST block of the chain and the
+ *  next pointer of the last block refers back to the first one. This way frames are appended without walking the
+ *  chain. The ring is opened into a plain NULL-terminated list when the blocks leave the RX state.
  */
 
 /**
@@ -1564,76 +2004,112 @@ CANARD_INTERNAL int16_t bufferBlockPushBytes(CanardPoolAllocator* allocator,
         }
     } // head is full.
 
-    uint16_t index_at_nth_block =
-        (uint16_t)(((state->payload_len) - CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE) % CANARD_BUFFER_BLOCK_DATA_SIZE);
-
-    // get to current block
-    CanardBufferBlock* block = NULL;
+    CanardBufferBlock* block = canardBufferFromIdx(allocator, state->buffer_blocks);
+    size_t index_at_block = (block == NULL) ? 0U : lastBufferBlockFill(state);
 
-    // buffer blocks uninitialized
-    if (state->buffer_blocks == CANARD_BUFFER_IDX_NONE)
+    // add data to the last block until it becomes full, add new block if necessary
+    while (data_index < data_len)
     {
-        block = createBufferBlock(allocator);
-        state->buffer_blocks = canardBufferToIdx(allocator, block);
-        if (block == NULL)
+        if (block == NULL || index_at_block >= CANARD_BUFFER_BLOCK_DATA_SIZE)
         {
-            return -CANARD_ERROR_OUT_OF_MEMORY;
+            block = appendBufferBlock(allocator, state);
+            if (block == NULL)
+            {
+                return -CANARD_ERROR_OUT_OF_MEMORY;
+            }
+            index_at_block = 0;
         }
 
-        index_at_nth_block = 0;
-    }
-    else
-    {
-        uint16_t nth_block = 1;
-
-        // get to block
-        block = canardBufferFromIdx(allocator, state->buffer_blocks);
-        while (block->next != NULL)
+        for (; index_at_block < CANARD_BUFFER_BLOCK_DATA_SIZE && data_index < data_len;
+             index_at_block++, data_index++)
         {
-            nth_block++;
-            block = block->next;
+            block->data[index_at_block] = data[data_index];
         }
+    }
 
-        const uint16_t num_buffer_blocks =
-            (uint16_t) (((((uint32_t)state->payload_len + data_len) - CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE) /
-                         CANARD_BUFFER_BLOCK_DATA_SIZE) + 1U);
+    state->payload_len = (uint16_t)(state->payload_len + data_len) & ((1U << CANARD_TRANSFER_PAYLOAD_LEN_BITS) - 1U);
 
-        if (num_buffer_blocks > nth_block && index_at_nth_block == 0)
-        {
-            block->next = createBufferBlock(allocator);
-            if (block->next == NULL)
-            {
-                return -CANARD_ERROR_OUT_OF_MEMORY;
-            }
-            block = block->next;
-        }
+    return 1;
+}
+
+/**
+ * Returns the number of payload bytes stored in the last buffer block; the state must have at least one block
+ */
+CANARD_INTERNAL size_t lastBufferBlockFill(const CanardRxState* state)
+{
+    CANARD_ASSERT(state->buffer_blocks != CANARD_BUFFER_IDX_NONE);
+    CANARD_ASSERT(state->payload_len > CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE);
+    return ((state->payload_len - CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE - 1U) % CANARD_BUFFER_BLOCK_DATA_SIZE) + 1U;
+}
+
+/**
+ * Allocates a new block and links it at the end of the block ring of the state
+ */
+CANARD_INTERNAL CanardBufferBlock* appendBufferBlock(CanardPoolAllocator* allocator, CanardRxState* state)
+{
+    CanardBufferBlock* const block = createBufferBlock(allocator);
+    if (block == NULL)
+    {
+        return NULL;
     }
 
-    // add data to current block until it becomes full, add new block if necessary
-    while (data_index < data_len)
+    CanardBufferBlock* const last = canardBufferFromIdx(allocator, state->buffer_blocks);
+    if (last == NULL)
     {
-        for (uint16_t i = index_at_nth_block;
-             i < CANARD_BUFFER_BLOCK_DATA_SIZE && data_index < data_len;
-             i++, data_index++)
-        {
-            block->data[i] = data[data_index];
-        }
+        block->next = block;
+    }
+    else
+    {
+        block->next = last->next;
+        last->next = block;
+    }
+    state->buffer_blocks = canardBufferToIdx(allocator, block);
+    return block;
+}
+
+/**
+ * Takes the block ring away from the state and returns it as a NULL-terminated list starting at the first block
+ */
+CANARD_INTERNAL CanardBufferBlock* detachBufferBlocks(CanardPoolAllocator* allocator, CanardRxState* state)
+{
+    CanardBufferBlock* const last = canardBufferFromIdx(allocator, state->buffer_blocks);
+    if (last == NULL)
+    {
+        return NULL;
+    }
+
+    CanardBufferBlock* const first = last->next;
+    last->next = NULL;
+    state->buffer_blocks = CANARD_BUFFER_IDX_NONE;
+    return first;
+}
 
-        if (data_index < data_len)
+CANARD_INTERNAL void gatherStatePayload(CanardPoolAllocator* allocator,
+                                        const CanardRxState* state,
+                                        const uint8_t* tail,
+                                        uint8_t tail_len,
+                                        uint8_t* output)
+{
+    const size_t head_len = (state->payload_len < CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE) ?
+                            state->payload_len : CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE;
+    memcpy(output, state->buffer_head, head_len);
+    size_t offset = head_len;
+
+    const CanardBufferBlock* const last = canardBufferFromIdx(allocator, state->buffer_blocks);
+    if (last != NULL)
+    {
+        for (const CanardBufferBlock* block = last->next; block != last; block = block->next)
         {
-            block->next = createBufferBlock(allocator);
-            if (block->next == NULL)
-            {
-                return -CANARD_ERROR_OUT_OF_MEMORY;
-            }
-            block = block->next;
-            index_at_nth_block = 0;
+            memcpy(&output[offset], block->data, CANARD_BUFFER_BLOCK_DATA_SIZE);
+            offset += CANARD_BUFFER_BLOCK_DATA_SIZE;
         }
+        const size_t last_fill = lastBufferBlockFill(state);
+        memcpy(&output[offset], last->data, last_fill);
+        offset += last_fill;
     }
 
-    state->payload_len = (uint16_t)(state->payload_len + data_len) & ((1U << CANARD_TRANSFER_PAYLOAD_LEN_BITS) - 1U);
-
-    return 1;
+    CANARD_ASSERT(offset == state->payload_len);
+    memcpy(&output[offset], tail, tail_len);
 }
 
 CANARD_INTERNAL CanardBufferBlock* createBufferBlock(CanardPoolAllocator* allocator)
@@ -1647,6 +2123,81 @@ CANARD_INTERNAL CanardBufferBlock* createBufferBlock(CanardPoolAllocator* alloca
     return block;
 }
 
+#if CANARD_ENABLE_FAST_SCALAR_CODEC
+/**
+ * Loads up to 8 bytes as a big-endian word, so that the first byte ends up in the most significant position.
+ * Only the specified number of bytes is accessed; the missing least significant bytes are zero.
+ */
+static inline uint64_t loadWordBigEndian(const uint8_t* bytes, size_t span)
+{
+    uint64_t word = 0;
+    if (span == 8U)
+    {
+        memcpy(&word, bytes, 8U);                   // Constant size lets the compiler emit a single load
+    }
+    else
+    {
+        memcpy(&word, bytes, span);
+    }
+    return __builtin_bswap64(word);
+}
+
+/**
+ * Counterpart of loadWordBigEndian().
+ */
+static inline void storeWordBigEndian(uint8_t* bytes, size_t span, uint64_t word)
+{
+    word = __builtin_bswap64(word);
+    if (span == 8U)
+    {
+        memcpy(bytes, &word, 8U);
+    }
+    else
+    {
+        memcpy(bytes, &word, span);
+    }
+}
+
+/**
+ * Bit array copy routine, word-at-a-time version.
+ * Every iteration moves as many bits as fit into one 64-bit word at both the source and the destination offset,
+ * i.e. at least 57 bits, and touches only the bytes spanned by those bits.
+ */
+void copyBitArray(const uint8_t* src, uint32_t src_offset, uint32_t src_len,
+                        uint8_t* dst, uint32_t dst_offset)
+{
+    CANARD_ASSERT(src_len > 0U);
+
+    // Normalizing inputs
+    src += src_offset / 8U;
+    dst += dst_offset / 8U;
+
+    src_offset %= 8U;
+    dst_offset %= 8U;
+
+    while (src_len > 0U)
+    {
+        const uint32_t max_offset = MAX(src_offset, dst_offset);
+        const uint32_t copy_bits = MIN(src_len, 64U - max_offset);
+
+        const uint64_t src_data = loadWordBigEndian(src, (src_offset + copy_bits + 7U) / 8U) << src_offset;
+        const uint64_t write_mask = (UINT64_MAX << (64U - copy_bits)) >> dst_offset;
+
+        const size_t dst_span = (dst_offset + copy_bits + 7U) / 8U;
+        const uint64_t dst_data = loadWordBigEndian(dst, dst_span);
+        storeWordBigEndian(dst, dst_span, (dst_data & ~write_mask) | ((src_data >> dst_offset) & write_mask));
+
+        src_offset += copy_bits;
+        dst_offset += copy_bits;
+        src += src_offset / 8U;
+        dst += dst_offset / 8U;
+        src_offset %= 8U;
+        dst_offset %= 8U;
+        src_len -= copy_bits;
+    }
+}
+
+#else
 /**
  * Bit array copy routine, originally developed by Ben Dyer for Libuavcan. Thanks Ben.
  */
@@ -1693,6 +2244,7 @@ void copyBitArray(const uint8_t* src, uint32_t src_offset, uint32_t src_len,
         dst_offset += copy_bits;
     }
 }
+#endif
 
 CANARD_INTERNAL int16_t descatterTransferPayload(const CanardRxTransfer* transfer,
                                                  uint32_t bit_offset,
@@ -1839,24 +2391,333 @@ CANARD_INTERNAL void swapByteOrder(void* data, unsigned size)
     }
 }
 
+#if CANARD_ENABLE_FAST_SCALAR_CODEC
 /*
- * CRC functions
+ * The serialized bit stream is MSB-first, so a field loaded big-endian and shifted to the top of a 64-bit word is
+ * left-aligned in stream order. Byte-swapping it yields the same layout that the generic path assembles in its
+ * temporary storage: whole bytes in little-endian order followed by the partial byte, which is left-aligned
+ * and therefore has to be shifted down.
  */
-CANARD_INTERNAL uint16_t crcAddByte(uint16_t crc_val, uint8_t byte)
+static uint8_t scalarStdByteLength(uint8_t bit_length)
+{
+    if      (bit_length == 1)   { return sizeof(bool); }
+    else if (bit_length <= 8)   { return 1; }
+    else if (bit_length <= 16)  { return 2; }
+    else if (bit_length <= 32)  { return 4; }
+    else                        { return 8; }
+}
+
+CANARD_INTERNAL void decodeContiguousScalar(const uint8_t* bytes,
+                                            uint32_t bit_offset,
+                                            uint8_t bit_length,
+                                            bool value_is_signed,
+                                            void* out_value)
+{
+    const uint8_t shift = (uint8_t)(bit_offset % 8U);
+    CANARD_ASSERT((shift + bit_length) <= 64U);
+
+    bytes += bit_offset / 8U;
+
+    // Byte-aligned standard sizes are stored exactly as they are laid out in memory
+    if ((shift == 0U) && ((bit_length == 8U) || (bit_length == 16U) || (bit_length == 32U) || (bit_length == 64U)))
+    {
+        memcpy(out_value, bytes, bit_length / 8U);
+        return;
+    }
+
+    const uint64_t word = (loadWordBigEndian(bytes, (shift + bit_length + 7U) / 8U) << shift) &
+                          (UINT64_MAX << (64U - bit_length));
+
+    uint64_t value = __builtin_bswap64(word);
+    const uint8_t partial_bits = (uint8_t)(bit_length % 8U);
+    if (partial_bits != 0U)
+    {
+        const uint8_t whole_bits = (uint8_t)(bit_length - partial_bits);
+        value = (value & ((((uint64_t) 1) << whole_bits) - 1U)) |
+                (((value >> whole_bits) >> (8U - partial_bits)) << whole_bits);
+    }
+
+    if (value_is_signed && (bit_length < 64U))
+    {
+        const uint64_t sign = ((uint64_t) 1) << (bit_length - 1U);
+        value = (value ^ sign) - sign;
+    }
+
+    memcpy(out_value, &value, scalarStdByteLength(bit_length));
+}
+
+CANARD_INTERNAL void encodeContiguousScalar(uint8_t* bytes,
+                                            uint32_t bit_offset,
+                                            uint8_t bit_length,
+                                            const void* value)
 {
-    crc_val ^= (uint16_t) ((uint16_t) (byte) << 8U);
-    for (uint8_t j = 0; j < 8; j++)
+    const uint8_t shift = (uint8_t)(bit_offset % 8U);
+    CANARD_ASSERT((shift + bit_length) <= 64U);
+
+    bytes += bit_offset / 8U;
+
+    if ((shift == 0U) && ((bit_length == 8U) || (bit_length == 16U) || (bit_length == 32U) || (bit_length == 64U)))
     {
-        if (crc_val & 0x8000U)
+        memcpy(bytes, value, bit_length / 8U);
+        return;
+    }
+
+    uint64_t field = 0;
+    if (bit_length == 1U)
+    {
+        field = (*((const bool*) value) != 0) ? 1U : 0U;
+    }
+    else
+    {
+        memcpy(&field, value, scalarStdByteLength(bit_length));
+    }
+
+    // Extra most significant bits are discarded, the partial byte is left-aligned
+    const uint8_t partial_bits = (uint8_t)(bit_length % 8U);
+    const uint8_t whole_bits = (uint8_t)(bit_length - partial_bits);
+    if (partial_bits != 0U)
+    {
+        const uint64_t partial = (field >> whole_bits) & ((1U << partial_bits) - 1U);
+        field = (field & ((((uint64_t) 1) << whole_bits) - 1U)) | ((partial << (8U - partial_bits)) << whole_bits);
+    }
+
+    const uint64_t stream = __builtin_bswap64(field) >> shift;
+    const uint64_t mask = (UINT64_MAX << (64U - bit_length)) >> shift;
+    const size_t span = (shift + bit_length + 7U) / 8U;
+
+    storeWordBigEndian(bytes, span, (loadWordBigEndian(bytes, span) & ~mask) | (stream & mask));
+}
+#endif
+
+#if CANARD_ENABLE_F16C
+CANARD_INTERNAL bool hasHardwareFloat16(void)
+{
+    return __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+}
+
+/**
+ * Converts a multiple of eight values using F16C.
+ * Groups that contain a NaN are redone in software, the hardware would quiet signaling NaNs.
+ */
+__attribute__((target("avx,f16c")))
+CANARD_INTERNAL void convertFloat16ArrayToNativeFloatF16C(const uint16_t* values, float* out_values, size_t count)
+{
+    CANARD_ASSERT((count % 8U) == 0U);
+
+    for (size_t i = 0; i < count; i += 8U)
+    {
+        const __m128i halves = _mm_loadu_si128((const __m128i*) &values[i]);
+        const __m256 floats = _mm256_cvtph_ps(halves);
+        _mm256_storeu_ps(&out_values[i], floats);
+
+        if (_mm256_movemask_ps(_mm256_cmp_ps(floats, floats, _CMP_UNORD_Q)) != 0)
         {
-            crc_val = (uint16_t) ((uint16_t) (crc_val << 1U) ^ 0x1021U);
+            for (size_t k = i; k < i + 8U; k++)
+            {
+                out_values[k] = canardConvertFloat16ToNativeFloat(values[k]);
+            }
+        }
+    }
+}
+
+/**
+ * Returns a mask of the lanes whose conversion by F16C may differ from canardConvertNativeFloatToFloat16().
+ * The two agree on normal results except for exact ties, which the hardware rounds to even and the software away
+ * from zero. Results below the smallest normal value and NaNs are left to the software as well.
+ */
+__attribute__((target("avx,f16c")))
+static inline __m128i float16MismatchLanes(__m128i bits)
+{
+    const __m128i magnitude = _mm_and_si128(bits, _mm_set1_epi32(0x7FFFFFFF));
+
+    const __m128i tie = _mm_cmpeq_epi32(_mm_and_si128(magnitude, _mm_set1_epi32(0x1FFF)), _mm_set1_epi32(0x1000));
+    const __m128i subnormal = _mm_andnot_si128(_mm_cmpeq_epi32(magnitude, _mm_setzero_si128()),
+                                               _mm_cmplt_epi32(magnitude, _mm_set1_epi32(0x38800000)));
+    const __m128i nan = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7F800000));
+
+    return _mm_or_si128(_mm_or_si128(tie, subnormal), nan);
+}
+
+/**
+ * Converts a multiple of eight values using F16C.
+ * Groups that contain a value the hardware would round differently are redone in software, so the result is
+ * always identical to canardConvertNativeFloatToFloat16().
+ */
+__attribute__((target("avx,f16c")))
+CANARD_INTERNAL void convertNativeFloatArrayToFloat16F16C(const float* values, uint16_t* out_values, size_t count)
+{
+    CANARD_ASSERT((count % 8U) == 0U);
+
+    for (size_t i = 0; i < count; i += 8U)
+    {
+        const __m256 floats = _mm256_loadu_ps(&values[i]);
+        const __m128i mismatch = _mm_or_si128(float16MismatchLanes(_mm_castps_si128(_mm256_castps256_ps128(floats))),
+                                              float16MismatchLanes(_mm_castps_si128(_mm256_extractf128_ps(floats, 1))));
+
+        if (_mm_movemask_epi8(mismatch) == 0)
+        {
+            _mm_storeu_si128((__m128i*) &out_values[i],
+                             _mm256_cvtps_ph(floats, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
         }
         else
         {
-            crc_val = (uint16_t) (crc_val << 1U);
+            for (size_t k = i; k < i + 8U; k++)
+            {
+                out_values[k] = canardConvertNativeFloatToFloat16(values[k]);
+            }
         }
     }
-    return crc_val;
+}
+#endif
+
+/*
+ * CRC functions
+ */
+/// CRC-16/CCITT lookup tables for slice-by-4 processing: CrcTable[k][x] is the register
+/// contribution of byte x followed by k zero bytes
+static const uint16_t CrcTable[4][256] =
+{
+    {
+        0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+        0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+        0x1231U, 0x0210U, 0x3273U, 0x2252U, 0x52B5U, 0x4294U, 0x72F7U, 0x62D6U,
+        0x9339U, 0x8318U, 0xB37BU, 0xA35AU, 0xD3BDU, 0xC39CU, 0xF3FFU, 0xE3DEU,
+        0x2462U, 0x3443U, 0x0420U, 0x1401U, 0x64E6U, 0x74C7U, 0x44A4U, 0x5485U,
+        0xA56AU, 0xB54BU, 0x8528U, 0x9509U, 0xE5EEU, 0xF5CFU, 0xC5ACU, 0xD58DU,
+        0x3653U, 0x2672U, 0x1611U, 0x0630U, 0x76D7U, 0x66F6U, 0x5695U, 0x46B4U,
+        0xB75BU, 0xA77AU, 0x9719U, 0x8738U, 0xF7DFU, 0xE7FEU, 0xD79DU, 0xC7BCU,
+        0x48C4U, 0x58E5U, 0x6886U, 0x78A7U, 0x0840U, 0x1861U, 0x2802U, 0x3823U,
+        0xC9CCU, 0xD9EDU, 0xE98EU, 0xF9AFU, 0x8948U, 0x9969U, 0xA90AU, 0xB92BU,
+        0x5AF5U, 0x4AD4U, 0x7AB7U, 0x6A96U, 0x1A71U, 0x0A50U, 0x3A33U, 0x2A12U,
+        0xDBFDU, 0xCBDCU, 0xFBBFU, 0xEB9EU, 0x9B79U, 0x8B58U, 0xBB3BU, 0xAB1AU,
+        0x6CA6U, 0x7C87U, 0x4CE4U, 0x5CC5U, 0x2C22U, 0x3C03U, 0x0C60U, 0x1C41U,
+        0xEDAEU, 0xFD8FU, 0xCDECU, 0xDDCDU, 0xAD2AU, 0xBD0BU, 0x8D68U, 0x9D49U,
+        0x7E97U, 0x6EB6U, 0x5ED5U, 0x4EF4U, 0x3E13U, 0x2E32U, 0x1E51U, 0x0E70U,
+        0xFF9FU, 0xEFBEU, 0xDFDDU, 0xCFFCU, 0xBF1BU, 0xAF3AU, 0x9F59U, 0x8F78U,
+        0x9188U, 0x81A9U, 0xB1CAU, 0xA1EBU, 0xD10CU, 0xC12DU, 0xF14EU, 0xE16FU,
+        0x1080U, 0x00A1U, 0x30C2U, 0x20E3U, 0x5004U, 0x4025U, 0x7046U, 0x6067U,
+        0x83B9U, 0x9398U, 0xA3FBU, 0xB3DAU, 0xC33DU, 0xD31CU, 0xE37FU, 0xF35EU,
+        0x02B1U, 0x1290U, 0x22F3U, 0x32D2U, 0x4235U, 0x5214U, 0x6277U, 0x7256U,
+        0xB5EAU, 0xA5CBU, 0x95A8U, 0x8589U, 0xF56EU, 0xE54FU, 0xD52CU, 0xC50DU,
+        0x34E2U, 0x24C3U, 0x14A0U, 0x0481U, 0x7466U, 0x6447U, 0x5424U, 0x4405U,
+        0xA7DBU, 0xB7FAU, 0x8799U, 0x97B8U, 0xE75FU, 0xF77EU, 0xC71DU, 0xD73CU,
+        0x26D3U, 0x36F2U, 0x0691U, 0x16B0U, 0x6657U, 0x7676U, 0x4615U, 0x5634U,
+        0xD94CU, 0xC96DU, 0xF90EU, 0xE92FU, 0x99C8U, 0x89E9U, 0xB98AU, 0xA9ABU,
+        0x5844U, 0x4865U, 0x7806U, 0x6827U, 0x18C0U, 0x08E1U, 0x3882U, 0x28A3U,
+        0xCB7DU, 0xDB5CU, 0xEB3FU, 0xFB1EU, 0x8BF9U, 0x9BD8U, 0xABBBU, 0xBB9AU,
+        0x4A75U, 0x5A54U, 0x6A37U, 0x7A16U, 0x0AF1U, 0x1AD0U, 0x2AB3U, 0x3A92U,
+        0xFD2EU, 0xED0FU, 0xDD6CU, 0xCD4DU, 0xBDAAU, 0xAD8BU, 0x9DE8U, 0x8DC9U,
+        0x7C26U, 0x6C07U, 0x5C64U, 0x4C45U, 0x3CA2U, 0x2C83U, 0x1CE0U, 0x0CC1U,
+        0xEF1FU, 0xFF3EU, 0xCF5DU, 0xDF7CU, 0xAF9BU, 0xBFBAU, 0x8FD9U, 0x9FF8U,
+        0x6E17U, 0x7E36U, 0x4E55U, 0x5E74U, 0x2E93U, 0x3EB2U, 0x0ED1U, 0x1EF0U
+    },
+    {
+        0x0000U, 0x3331U, 0x6662U, 0x5553U, 0xCCC4U, 0xFFF5U, 0xAAA6U, 0x9997U,
+        0x89A9U, 0xBA98U, 0xEFCBU, 0xDCFAU, 0x456DU, 0x765CU, 0x230FU, 0x103EU,
+        0x0373U, 0x3042U, 0x6511U, 0x5620U, 0xCFB7U, 0xFC86U, 0xA9D5U, 0x9AE4U,
+        0x8ADAU, 0xB9EBU, 0xECB8U, 0xDF89U, 0x461EU, 0x752FU, 0x207CU, 0x134DU,
+        0x06E6U, 0x35D7U, 0x6084U, 0x53B5U, 0xCA22U, 0xF913U, 0xAC40U, 0x9F71U,
+        0x8F4FU, 0xBC7EU, 0xE92DU, 0xDA1CU, 0x438BU, 0x70BAU, 0x25E9U, 0x16D8U,
+        0x0595U, 0x36A4U, 0x63F7U, 0x50C6U, 0xC951U, 0xFA60U, 0xAF33U, 0x9C02U,
+        0x8C3CU, 0xBF0DU, 0xEA5EU, 0xD96FU, 0x40F8U, 0x73C9U, 0x269AU, 0x15ABU,
+        0x0DCCU, 0x3EFDU, 0x6BAEU, 0x589FU, 0xC108U, 0xF239U, 0xA76AU, 0x945BU,
+        0x8465U, 0xB754U, 0xE207U, 0xD136U, 0x48A1U, 0x7B90U, 0x2EC3U, 0x1DF2U,
+        0x0EBFU, 0x3D8EU, 0x68DDU, 0x5BECU, 0xC27BU, 0xF14AU, 0xA419U, 0x9728U,
+        0x8716U, 0xB427U, 0xE174U, 0xD245U, 0x4BD2U, 0x78E3U, 0x2DB0U, 0x1E81U,
+        0x0B2AU, 0x381BU, 0x6D48U, 0x5E79U, 0xC7EEU, 0xF4DFU, 0xA18CU, 0x92BDU,
+        0x8283U, 0xB1B2U, 0xE4E1U, 0xD7D0U, 0x4E47U, 0x7D76U, 0x2825U, 0x1B14U,
+        0x0859U, 0x3B68U, 0x6E3BU, 0x5D0AU, 0xC49DU, 0xF7ACU, 0xA2FFU, 0x91CEU,
+        0x81F0U, 0xB2C1U, 0xE792U, 0xD4A3U, 0x4D34U, 0x7E05U, 0x2B56U, 0x1867U,
+        0x1B98U, 0x28A9U, 0x7DFAU, 0x4ECBU, 0xD75CU, 0xE46DU, 0xB13EU, 0x820FU,
+        0x9231U, 0xA100U, 0xF453U, 0xC762U, 0x5EF5U, 0x6DC4U, 0x3897U, 0x0BA6U,
+        0x18EBU, 0x2BDAU, 0x7E89U, 0x4DB8U, 0xD42FU, 0xE71EU, 0xB24DU, 0x817CU,
+        0x9142U, 0xA273U, 0xF720U, 0xC411U, 0x5D86U, 0x6EB7U, 0x3BE4U, 0x08D5U,
+        0x1D7EU, 0x2E4FU, 0x7B1CU, 0x482DU, 0xD1BAU, 0xE28BU, 0xB7D8U, 0x84E9U,
+        0x94D7U, 0xA7E6U, 0xF2B5U, 0xC184U, 0x5813U, 0x6B22U, 0x3E71U, 0x0D40U,
+        0x1E0DU, 0x2D3CU, 0x786FU, 0x4B5EU, 0xD2C9U, 0xE1F8U, 0xB4ABU, 0x879AU,
+        0x97A4U, 0xA495U, 0xF1C6U, 0xC2F7U, 0x5B60U, 0x6851U, 0x3D02U, 0x0E33U,
+        0x1654U, 0x2565U, 0x7036U, 0x4307U, 0xDA90U, 0xE9A1U, 0xBCF2U, 0x8FC3U,
+        0x9FFDU, 0xACCCU, 0xF99FU, 0xCAAEU, 0x5339U, 0x6008U, 0x355BU, 0x066AU,
+        0x1527U, 0x2616U, 0x7345U, 0x4074U, 0xD9E3U, 0xEAD2U, 0xBF81U, 0x8CB0U,
+        0x9C8EU, 0xAFBFU, 0xFAECU, 0xC9DDU, 0x504AU, 0x637BU, 0x3628U, 0x0519U,
+        0x10B2U, 0x2383U, 0x76D0U, 0x45E1U, 0xDC76U, 0xEF47U, 0xBA14U, 0x8925U,
+        0x991BU, 0xAA2AU, 0xFF79U, 0xCC48U, 0x55DFU, 0x66EEU, 0x33BDU, 0x008CU,
+        0x13C1U, 0x20F0U, 0x75A3U, 0x4692U, 0xDF05U, 0xEC34U, 0xB967U, 0x8A56U,
+        0x9A68U, 0xA959U, 0xFC0AU, 0xCF3BU, 0x56ACU, 0x659DU, 0x30CEU, 0x03FFU
+    },
+    {
+        0x0000U, 0x3730U, 0x6E60U, 0x5950U, 0xDCC0U, 0xEBF0U, 0xB2A0U, 0x8590U,
+        0xA9A1U, 0x9E91U, 0xC7C1U, 0xF0F1U, 0x7561U, 0x4251U, 0x1B01U, 0x2C31U,
+        0x4363U, 0x7453U, 0x2D03U, 0x1A33U, 0x9FA3U, 0xA893U, 0xF1C3U, 0xC6F3U,
+        0xEAC2U, 0xDDF2U, 0x84A2U, 0xB392U, 0x3602U, 0x0132U, 0x5862U, 0x6F52U,
+        0x86C6U, 0xB1F6U, 0xE8A6U, 0xDF96U, 0x5A06U, 0x6D36U, 0x3466U, 0x0356U,
+        0x2F67U, 0x1857U, 0x4107U, 0x7637U, 0xF3A7U, 0xC497U, 0x9DC7U, 0xAAF7U,
+        0xC5A5U, 0xF295U, 0xABC5U, 0x9CF5U, 0x1965U, 0x2E55U, 0x7705U, 0x4035U,
+        0x6C04U, 0x5B34U, 0x0264U, 0x3554U, 0xB0C4U, 0x87F4U, 0xDEA4U, 0xE994U,
+        0x1DADU, 0x2A9DU, 0x73CDU, 0x44FDU, 0xC16DU, 0xF65DU, 0xAF0DU, 0x983DU,
+        0xB40CU, 0x833CU, 0xDA6CU, 0xED5CU, 0x68CCU, 0x5FFCU, 0x06ACU, 0x319CU,
+        0x5ECEU, 0x69FEU, 0x30AEU, 0x079EU, 0x820EU, 0xB53EU, 0xEC6EU, 0xDB5EU,
+        0xF76FU, 0xC05FU, 0x990FU, 0xAE3FU, 0x2BAFU, 0x1C9FU, 0x45CFU, 0x72FFU,
+        0x9B6BU, 0xAC5BU, 0xF50BU, 0xC23BU, 0x47ABU, 0x709BU, 0x29CBU, 0x1EFBU,
+        0x32CAU, 0x05FAU, 0x5CAAU, 0x6B9AU, 0xEE0AU, 0xD93AU, 0x806AU, 0xB75AU,
+        0xD808U, 0xEF38U, 0xB668U, 0x8158U, 0x04C8U, 0x33F8U, 0x6AA8U, 0x5D98U,
+        0x71A9U, 0x4699U, 0x1FC9U, 0x28F9U, 0xAD69U, 0x9A59U, 0xC309U, 0xF439U,
+        0x3B5AU, 0x0C6AU, 0x553AU, 0x620AU, 0xE79AU, 0xD0AAU, 0x89FAU, 0xBECAU,
+        0x92FBU, 0xA5CBU, 0xFC9BU, 0xCBABU, 0x4E3BU, 0x790BU, 0x205BU, 0x176BU,
+        0x7839U, 0x4F09U, 0x1659U, 0x2169U, 0xA4F9U, 0x93C9U, 0xCA99U, 0xFDA9U,
+        0xD198U, 0xE6A8U, 0xBFF8U, 0x88C8U, 0x0D58U, 0x3A68U, 0x6338U, 0x5408U,
+        0xBD9CU, 0x8AACU, 0xD3FCU, 0xE4CCU, 0x615CU, 0x566CU, 0x0F3CU, 0x380CU,
+        0x143DU, 0x230DU, 0x7A5DU, 0x4D6DU, 0xC8FDU, 0xFFCDU, 0xA69DU, 0x91ADU,
+        0xFEFFU, 0xC9CFU, 0x909FU, 0xA7AFU, 0x223FU, 0x150FU, 0x4C5FU, 0x7B6FU,
+        0x575EU, 0x606EU, 0x393EU, 0x0E0EU, 0x8B9EU, 0xBCAEU, 0xE5FEU, 0xD2CEU,
+        0x26F7U, 0x11C7U, 0x4897U, 0x7FA7U, 0xFA37U, 0xCD07U, 0x9457U, 0xA367U,
+        0x8F56U, 0xB866U, 0xE136U, 0xD606U, 0x5396U, 0x64A6U, 0x3DF6U, 0x0AC6U,
+        0x6594U, 0x52A4U, 0x0BF4U, 0x3CC4U, 0xB954U, 0x8E64U, 0xD734U, 0xE004U,
+        0xCC35U, 0xFB05U, 0xA255U, 0x9565U, 0x10F5U, 0x27C5U, 0x7E95U, 0x49A5U,
+        0xA031U, 0x9701U, 0xCE51U, 0xF961U, 0x7CF1U, 0x4BC1U, 0x1291U, 0x25A1U,
+        0x0990U, 0x3EA0U, 0x67F0U, 0x50C0U, 0xD550U, 0xE260U, 0xBB30U, 0x8C00U,
+        0xE352U, 0xD462U, 0x8D32U, 0xBA02U, 0x3F92U, 0x08A2U, 0x51F2U, 0x66C2U,
+        0x4AF3U, 0x7DC3U, 0x2493U, 0x13A3U, 0x9633U, 0xA103U, 0xF853U, 0xCF63U
+    },
+    {
+        0x0000U, 0x76B4U, 0xED68U, 0x9BDCU, 0xCAF1U, 0xBC45U, 0x2799U, 0x512DU,
+        0x85C3U, 0xF377U, 0x68ABU, 0x1E1FU, 0x4F32U, 0x3986U, 0xA25AU, 0xD4EEU,
+        0x1BA7U, 0x6D13U, 0xF6CFU, 0x807BU, 0xD156U, 0xA7E2U, 0x3C3EU, 0x4A8AU,
+        0x9E64U, 0xE8D0U, 0x730CU, 0x05B8U, 0x5495U, 0x2221U, 0xB9FDU, 0xCF49U,
+        0x374EU, 0x41FAU, 0xDA26U, 0xAC92U, 0xFDBFU, 0x8B0BU, 0x10D7U, 0x6663U,
+        0xB28DU, 0xC439U, 0x5FE5U, 0x2951U, 0x787CU, 0x0EC8U, 0x9514U, 0xE3A0U,
+        0x2CE9U, 0x5A5DU, 0xC181U, 0xB735U, 0xE618U, 0x90ACU, 0x0B70U, 0x7DC4U,
+        0xA92AU, 0xDF9EU, 0x4442U, 0x32F6U, 0x63DBU, 0x156FU, 0x8EB3U, 0xF807U,
+        0x6E9CU, 0x1828U, 0x83F4U, 0xF540U, 0xA46DU, 0xD2D9U, 0x4905U, 0x3FB1U,
+        0xEB5FU, 0x9DEBU, 0x0637U, 0x7083U, 0x21AEU, 0x571AU, 0xCCC6U, 0xBA72U,
+        0x753BU, 0x038FU, 0x9853U, 0xEEE7U, 0xBFCAU, 0xC97EU, 0x52A2U, 0x2416U,
+        0xF0F8U, 0x864CU, 0x1D90U, 0x6B24U, 0x3A09U, 0x4CBDU, 0xD761U, 0xA1D5U,
+        0x59D2U, 0x2F66U, 0xB4BAU, 0xC20EU, 0x9323U, 0xE597U, 0x7E4BU, 0x08FFU,
+        0xDC11U, 0xAAA5U, 0x3179U, 0x47CDU, 0x16E0U, 0x6054U, 0xFB88U, 0x8D3CU,
+        0x4275U, 0x34C1U, 0xAF1DU, 0xD9A9U, 0x8884U, 0xFE30U, 0x65ECU, 0x1358U,
+        0xC7B6U, 0xB102U, 0x2ADEU, 0x5C6AU, 0x0D47U, 0x7BF3U, 0xE02FU, 0x969BU,
+        0xDD38U, 0xAB8CU, 0x3050U, 0x46E4U, 0x17C9U, 0x617DU, 0xFAA1U, 0x8C15U,
+        0x58FBU, 0x2E4FU, 0xB593U, 0xC327U, 0x920AU, 0xE4BEU, 0x7F62U, 0x09D6U,
+        0xC69FU, 0xB02BU, 0x2BF7U, 0x5D43U, 0x0C6EU, 0x7ADAU, 0xE106U, 0x97B2U,
+        0x435CU, 0x35E8U, 0xAE34U, 0xD880U, 0x89ADU, 0xFF19U, 0x64C5U, 0x1271U,
+        0xEA76U, 0x9CC2U, 0x071EU, 0x71AAU, 0x2087U, 0x5633U, 0xCDEFU, 0xBB5BU,
+        0x6FB5U, 0x1901U, 0x82DDU, 0xF469U, 0xA544U, 0xD3F0U, 0x482CU, 0x3E98U,
+        0xF1D1U, 0x8765U, 0x1CB9U, 0x6A0DU, 0x3B20U, 0x4D94U, 0xD648U, 0xA0FCU,
+        0x7412U, 0x02A6U, 0x997AU, 0xEFCEU, 0xBEE3U, 0xC857U, 0x538BU, 0x253FU,
+        0xB3A4U, 0xC510U, 0x5ECCU, 0x2878U, 0x7955U, 0x0FE1U, 0x943DU, 0xE289U,
+        0x3667U, 0x40D3U, 0xDB0FU, 0xADBBU, 0xFC96U, 0x8A22U, 0x11FEU, 0x674AU,
+        0xA803U, 0xDEB7U, 0x456BU, 0x33DFU, 0x62F2U, 0x1446U, 0x8F9AU, 0xF92EU,
+        0x2DC0U, 0x5B74U, 0xC0A8U, 0xB61CU, 0xE731U, 0x9185U, 0x0A59U, 0x7CEDU,
+        0x84EAU, 0xF25EU, 0x6982U, 0x1F36U, 0x4E1BU, 0x38AFU, 0xA373U, 0xD5C7U,
+        0x0129U, 0x779DU, 0xEC41U, 0x9AF5U, 0xCBD8U, 0xBD6CU, 0x26B0U, 0x5004U,
+        0x9F4DU, 0xE9F9U, 0x7225U, 0x0491U, 0x55BCU, 0x2308U, 0xB8D4U, 0xCE60U,
+        0x1A8EU, 0x6C3AU, 0xF7E6U, 0x8152U, 0xD07FU, 0xA6CBU, 0x3D17U, 0x4BA3U
+    }
+};
+
+CANARD_INTERNAL uint16_t crcAddByte(uint16_t crc_val, uint8_t byte)
+{
+    return (uint16_t) ((uint16_t) (crc_val << 8U) ^ CrcTable[0][((uint32_t) (crc_val >> 8U) ^ byte) & 0xFFU]);
 }
 
 CANARD_INTERNAL uint16_t crcAddSignature(uint16_t crc_val, uint64_t data_type_signature)
@@ -1870,6 +2731,16 @@ CANARD_INTERNAL uint16_t crcAddSignature(uint16_t crc_val, uint64_t data_type_si
 
 CANARD_INTERNAL uint16_t crcAdd(uint16_t crc_val, const uint8_t* bytes, size_t len)
 {
+    // Slice-by-4: the first two bytes overlap the 16-bit register, the other two are shifted in through zeros
+    while (len >= 4U)
+    {
+        crc_val = (uint16_t) (CrcTable[3][((uint32_t) (crc_val >> 8U) ^ bytes[0]) & 0xFFU] ^
+                              CrcTable[2][((uint32_t) crc_val ^ bytes[1]) & 0xFFU] ^
+                              CrcTable[1][bytes[2] & 0xFFU] ^
+                              CrcTable[0][bytes[3] & 0xFFU]);
+        bytes += 4;
+        len -= 4U;
+    }
     while (len--)
     {
         crc_val = crcAddByte(crc_val, *bytes++);
@@ -1877,26 +2748,58 @@ CANARD_INTERNAL uint16_t crcAdd(uint16_t crc_val, const uint8_t* bytes, size_t l
     return crc_val;
 }
 
+CANARD_INTERNAL uint16_t crcSignatureSeed(CanardInstance* ins, uint64_t data_type_signature)
+{
+    const uint32_t folded = (uint32_t) (data_type_signature ^ (data_type_signature >> 32U));
+    CanardCrcSignatureCacheEntry* const entry =
+        &ins->crc_signature_cache[(folded ^ (folded >> 16U)) & (CANARD_CRC_SIGNATURE_CACHE_SIZE - 1U)];
+
+    if (!entry->valid || entry->data_type_signature != data_type_signature)
+    {
+        entry->data_type_signature = data_type_signature;
+        entry->crc = crcAddSignature(0xFFFFU, data_type_signature);
+        entry->valid = true;
+    }
+    return entry->crc;
+}
+
 /*
  *  Pool Allocator functions
  */
 CANARD_INTERNAL void initPoolAllocator(CanardPoolAllocator* allocator,
                                        void* buf,
-                                       uint16_t buf_len)
+                                       size_t buf_size,
+                                       uint16_t block_size)
 {
+    size_t buf_len = buf_size / block_size;
+    if (buf_len > POOL_MAX_BLOCKS(block_size))
+    {
+        buf_len = POOL_MAX_BLOCKS(block_size);
+    }
+
     size_t current_index = 0;
-    CanardPoolAllocatorBlock *abuf = buf;
     allocator->arena = buf;
+    allocator->block_size = block_size;
+#if CANARD_ENABLE_LOCKFREE_ALLOCATOR
+    while (current_index < buf_len)
+    {
+        POOL_BLOCK_AT(allocator, current_index)->next_index =
+            (current_index + 1U < buf_len) ? (uint32_t)(current_index + 2U) : 0U;
+        current_index++;
+    }
+    allocator->free_head = MAKE_FREE_HEAD(0U, (buf_len > 0U) ? 1U : 0U);
+#else
     CanardPoolAllocatorBlock** current_block = &(allocator->free_list);
     while (current_index < buf_len)
     {
-        *current_block = &abuf[current_index];
+        *current_block = POOL_BLOCK_AT(allocator, current_index);
         current_block = &((*current_block)->next);
         current_index++;
     }
     *current_block = NULL;
+#endif
 
-    allocator->statistics.capacity_blocks = buf_len;
+    allocator->statistics.capacity_blocks = (uint32_t) buf_len;
     allocator->statistics.current_usage_blocks = 0;
     allocator->statistics.peak_usage_blocks = 0;
     // user should initialize semaphore after the canardInit
@@ -1904,6 +2807,112 @@ CANARD_INTERNAL void initPoolAllocator(CanardPoolAllocator* allocator,
     allocator->semaphore = NULL;
 }
 
+CANARD_INTERNAL CanardPoolAllocatorStatistics readPoolAllocatorStatistics(const CanardPoolAllocator* allocator)
+{
+#if CANARD_ENABLE_LOCKFREE_ALLOCATOR
+    CanardPoolAllocatorStatistics statistics;
+    statistics.capacity_blocks = allocator->statistics.capacity_blocks;
+    statistics.current_usage_blocks = __atomic_load_n(&allocator->statistics.current_usage_blocks, __ATOMIC_RELAXED);
+    statistics.peak_usage_blocks = __atomic_load_n(&allocator->statistics.peak_usage_blocks, __ATOMIC_RELAXED);
+    return statistics;
+#else
+    return allocator->statistics;
+#endif
+}
+
+CANARD_INTERNAL CanardPoolAllocator* txAllocator(CanardInstance* ins)
+{
+#if POOL_SIZE_CLASSES
+    return &ins->tx_allocator;
+#else
+    return (ins->tx_allocator.arena != NULL) ? &ins->tx_allocator : &ins->allocator;
+#endif
+}
+
+CANARD_INTERNAL void initPools(CanardInstance* ins, void* tx_arena, size_t tx_arena_size)
+{
+    size_t rx_arena_size = ins->pool_arena_size;
+#if POOL_SIZE_CLASSES
+    // TX items cannot be carved from the RX pool, so without an arena of its own the TX pool takes a fixed share
+    if ((tx_arena == NULL) || (tx_arena_size < CANARD_MEM_BLOCK_SIZE))
+    {
+        rx_arena_size = (rx_arena_size - rx_arena_size / 100U * CANARD_TX_POOL_PERCENT) /
+                        CANARD_RX_BLOCK_SIZE * CANARD_RX_BLOCK_SIZE;
+        tx_arena = (uint8_t*) ins->pool_arena + rx_arena_size;
+        tx_arena_size = ins->pool_arena_size - rx_arena_size;
+    }
+#endif
+
+    // Every RX block that holds an RX state needs a timer wheel link, the links follow the blocks
+    const size_t rx_blocks = rx_arena_size / (CANARD_RX_BLOCK_SIZE + sizeof(uint32_t));
+    ins->rx_timer_wheel_links = (uint32_t*) ((uint8_t*) ins->pool_arena + rx_blocks * CANARD_RX_BLOCK_SIZE);
+
+    initPoolAllocator(&ins->allocator, ins->pool_arena, rx_blocks * CANARD_RX_BLOCK_SIZE, CANARD_RX_BLOCK_SIZE);
+    initTxPool(ins, tx_arena, tx_arena_size);
+}
+
+CANARD_INTERNAL void initTxPool(CanardInstance* ins, void* tx_arena, size_t tx_arena_size)
+{
+    if ((tx_arena == NULL) || (tx_arena_size < CANARD_MEM_BLOCK_SIZE))
+    {
+        memset(&ins->tx_allocator, 0, sizeof(ins->tx_allocator));
+        return;
+    }
+    initPoolAllocator(&ins->tx_allocator, tx_arena, tx_arena_size, CANARD_MEM_BLOCK_SIZE);
+}
+
+#if CANARD_ENABLE_LOCKFREE_ALLOCATOR
+CANARD_INTERNAL void* allocateBlock(CanardPoolAllocator* allocator)
+{
+    uint64_t head = __atomic_load_n(&allocator->free_head, __ATOMIC_ACQUIRE);
+    uint64_t new_head = 0;
+    do
+    {
+        const uint32_t index = FREE_HEAD_INDEX(head);
+        if (index == 0U)
+        {
+            return NULL;
+        }
+        // Another thread may take the block and overwrite its link after the head was read. The link is then garbage,
+        // but the tag has changed as well, so the exchange below fails and the loop starts over with the new head.
+        const uint32_t next_index = __atomic_load_n(&POOL_BLOCK_AT(allocator, index - 1U)->next_index,
+                                                    __ATOMIC_RELAXED);
+        new_head = MAKE_FREE_HEAD(FREE_HEAD_TAG(head) + 1U, next_index);
+    }
+    while (!__atomic_compare_exchange_n(&allocator->free_head, &head, new_head, true,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+
+    // Counted after the block has left the list and freeBlock() uncounts before returning it, so the usage never
+    // exceeds the capacity, it can only lag behind for a moment
+    const uint32_t usage = __atomic_add_fetch(&allocator->statistics.current_usage_blocks, 1U, __ATOMIC_RELAXED);
+    uint32_t peak = __atomic_load_n(&allocator->statistics.peak_usage_blocks, __ATOMIC_RELAXED);
+    while (peak < usage &&
+           !__atomic_compare_exchange_n(&allocator->statistics.peak_usage_blocks, &peak, usage, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+
+    return POOL_BLOCK_AT(allocator, FREE_HEAD_INDEX(head) - 1U);
+}
+
+CANARD_INTERNAL void freeBlock(CanardPoolAllocator* allocator, void* p)
+{
+    CanardPoolAllocatorBlock* block = (CanardPoolAllocatorBlock*) p;
+    const uint32_t index = (uint32_t)(((uint8_t*) block - (uint8_t*) allocator->arena) / allocator->block_size) + 1U;
+
+    CANARD_ASSERT(__atomic_load_n(&allocator->statistics.current_usage_blocks, __ATOMIC_RELAXED) > 0);
+    __atomic_sub_fetch(&allocator->statistics.current_usage_blocks, 1U, __ATOMIC_RELAXED);
+
+    // Release ordering publishes the link and everything the caller wrote to the block to the next allocating thread
+    uint64_t head = __atomic_load_n(&allocator->free_head, __ATOMIC_RELAXED);
+    do
+    {
+        __atomic_store_n(&block->next_index, FREE_HEAD_INDEX(head), __ATOMIC_RELAXED);
+    }
+    while (!__atomic_compare_exchange_n(&allocator->free_head, &head, MAKE_FREE_HEAD(FREE_HEAD_TAG(head) + 1U, index),
+                                        true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+#else
 CANARD_INTERNAL void* allocateBlock(CanardPoolAllocator* allocator)
 {
 #if CANARD_ALLOCATE_SEM
@@ -1950,3 +2959,4 @@ CANARD_INTERNAL void freeBlock(CanardPoolAllocator* allocator, void* p)
     canard_allocate_sem_give(allocator);
 #endif
 }
+#endif
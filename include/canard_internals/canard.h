@@ -92,6 +92,28 @@ extern "C" {
 #ifndef CANARD_ALLOCATE_SEM
 #define CANARD_ALLOCATE_SEM 0
 #endif
+
+/// Makes the pool allocator itself lock-free: the free list becomes a lock-free stack and the allocator statistics
+/// are updated atomically, without the CANARD_ALLOCATE_SEM hooks.
+/// This does NOT make the instance thread-safe. The TX queue, the RX states and the CRC signature cache are shared
+/// by the send and receive paths and are not synchronized, so all calls of canardBroadcast*(),
+/// canardRequestOrRespond*(), canardHandleRxFrame*(), the TX queue functions, canardReleaseRxTransferPayload() and
+/// canardCleanupStaleTransfers() must still be serialized by the application, e.g. by running them on one thread.
+/// The only calls that may run on other threads at the same time are canardGetPoolAllocatorStatistics() and
+/// canardGetTxPoolAllocatorStatistics(), e.g. for a monitoring thread.
+/// Requires the GCC/Clang __atomic builtins with a 64-bit compare-and-swap (libatomic on some 32-bit targets).
+#ifndef CANARD_ENABLE_LOCKFREE_ALLOCATOR
+#define CANARD_ENABLE_LOCKFREE_ALLOCATOR 0
+#endif
+
+#if CANARD_ENABLE_LOCKFREE_ALLOCATOR
+# if CANARD_ALLOCATE_SEM
+#  error "CANARD_ENABLE_LOCKFREE_ALLOCATOR replaces CANARD_ALLOCATE_SEM, enable only one of them"
+# endif
+# if !defined(__GNUC__)
+#  error "CANARD_ENABLE_LOCKFREE_ALLOCATOR requires the __atomic builtins"
+# endif
+#endif
 /// Error code definitions; inverse of these values may be returned from API calls.
 #define CANARD_OK                                      0
 // Value 1 is omitted intentionally, since -1 is often used in 3rd party code
@@ -108,7 +130,10 @@ extern "C" {
 #define CANARD_ERROR_RX_SHORT_FRAME                    16
 #define CANARD_ERROR_RX_BAD_CRC                        17
 
-/// The size of a memory block in bytes.
+/// Number of CANARD_ERROR_RX_* codes, see CanardTransportStatistics
+#define CANARD_RX_ERROR_COUNT                          (CANARD_ERROR_RX_BAD_CRC - CANARD_ERROR_RX_INCOMPATIBLE_PACKET + 1)
+
+/// The size of a memory block holding a TX queue item, in bytes.
 #if CANARD_ENABLE_CANFD
 #define CANARD_MEM_BLOCK_SIZE                       128U
 #elif CANARD_ENABLE_DEADLINE
@@ -117,6 +142,17 @@ extern "C" {
 #define CANARD_MEM_BLOCK_SIZE                       32U
 #endif
 
+/// The size of a memory block holding an RX transfer state or a piece of a received payload, in bytes.
+/// Received payload is spread over as many blocks as needed, so these blocks stay small with CAN FD as well. Where it
+/// differs from CANARD_MEM_BLOCK_SIZE, RX and TX blocks are taken from separate pools, see canardInit().
+#define CANARD_RX_BLOCK_SIZE                        32U
+
+/// Percentage of the canardInit() arena given to the TX queue pool when RX and TX blocks differ in size and no
+/// separate TX arena is set with canardSetTxArena().
+#ifndef CANARD_TX_POOL_PERCENT
+#define CANARD_TX_POOL_PERCENT                      50U
+#endif
+
 #define CANARD_CAN_FRAME_MAX_DATA_LEN               8U
 #if CANARD_ENABLE_CANFD
 #define CANARD_CANFD_FRAME_MAX_DATA_LEN             64U
@@ -128,20 +164,46 @@ extern "C" {
 #define CANARD_MAX_NODE_ID                          127
 
 /// Refer to the type CanardRxTransfer
-#define CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE      (CANARD_MEM_BLOCK_SIZE - offsetof(CanardRxState, buffer_head))
+#define CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE      (CANARD_RX_BLOCK_SIZE - offsetof(CanardRxState, buffer_head))
 
 /// Refer to the type CanardBufferBlock
-#define CANARD_BUFFER_BLOCK_DATA_SIZE               (CANARD_MEM_BLOCK_SIZE - offsetof(CanardBufferBlock, data))
+#define CANARD_BUFFER_BLOCK_DATA_SIZE               (CANARD_RX_BLOCK_SIZE - offsetof(CanardBufferBlock, data))
+
+/// Number of hash buckets used to index RX transfer states. Must be a power of two.
+/// The bucket table is carved from the beginning of the memory arena passed to canardInit() and takes
+/// sizeof(canard_buffer_idx_t) bytes per bucket. The default keeps the chains around two states long with one
+/// transfer per node on a full bus of 127 nodes.
+#ifndef CANARD_RX_STATE_HASH_BUCKETS
+#define CANARD_RX_STATE_HASH_BUCKETS                64U
+#endif
+
+/// Number of data type signatures whose CRC seed is cached per instance. Must be a power of two.
+#ifndef CANARD_CRC_SIGNATURE_CACHE_SIZE
+#define CANARD_CRC_SIGNATURE_CACHE_SIZE             4U
+#endif
 
 /// Refer to canardCleanupStaleTransfers() for details.
 #define CANARD_RECOMMENDED_STALE_TRANSFER_CLEANUP_INTERVAL_USEC     1000000U
 
+/// Resolution of the hashed timer wheel that expires stale RX transfer states, see canardCleanupStaleTransfers().
+#ifndef CANARD_RX_TIMER_WHEEL_TICK_USEC
+#define CANARD_RX_TIMER_WHEEL_TICK_USEC             250000U
+#endif
+
+/// Number of slots of the above timer wheel. Must be a power of two.
+/// Every block of the RX pool has a 4 byte link for the wheel, which is carved from the canardInit() arena right after
+/// the RX blocks, so a block takes CANARD_RX_BLOCK_SIZE + 4 bytes of the arena.
+#ifndef CANARD_RX_TIMER_WHEEL_SLOTS
+#define CANARD_RX_TIMER_WHEEL_SLOTS                 16U
+#endif
+
 /// Transfer priority definitions
 #define CANARD_TRANSFER_PRIORITY_HIGHEST            0
 #define CANARD_TRANSFER_PRIORITY_HIGH               8
 #define CANARD_TRANSFER_PRIORITY_MEDIUM             16
 #define CANARD_TRANSFER_PRIORITY_LOW                24
 #define CANARD_TRANSFER_PRIORITY_LOWEST             31
+#define CANARD_TRANSFER_PRIORITY_LEVELS             (CANARD_TRANSFER_PRIORITY_LOWEST + 1)
 
 /// Related to CanardCANFrame
 #define CANARD_CAN_EXT_ID_MASK                      0x1FFFFFFFU
@@ -303,12 +365,15 @@ typedef void (* CanardOnTransferReception)(CanardInstance* ins,
 
 /**
  * INTERNAL DEFINITION, DO NOT USE DIRECTLY.
- * A memory block used in the memory block allocator.
+ * A memory block used in the memory block allocator. Only the beginning is shown, blocks are block_size bytes long.
  */
 typedef union CanardPoolAllocatorBlock_u
 {
-    char bytes[CANARD_MEM_BLOCK_SIZE];
+    char bytes[CANARD_RX_BLOCK_SIZE];
     union CanardPoolAllocatorBlock_u* next;
+#if CANARD_ENABLE_LOCKFREE_ALLOCATOR
+    uint32_t next_index;                    ///< Index of the next free block plus one, 0 at the end of the list
+#endif
 } CanardPoolAllocatorBlock;
 
 /**
@@ -317,11 +382,62 @@ typedef union CanardPoolAllocatorBlock_u
  */
 typedef struct
 {
-    uint16_t capacity_blocks;               ///< Pool capacity in number of blocks
-    uint16_t current_usage_blocks;          ///< Number of blocks that are currently allocated by the library
-    uint16_t peak_usage_blocks;             ///< Maximum number of blocks used since initialization
+    uint32_t capacity_blocks;               ///< Pool capacity in number of blocks
+    uint32_t current_usage_blocks;          ///< Number of blocks that are currently allocated by the library
+    uint32_t peak_usage_blocks;             ///< Maximum number of blocks used since initialization
 } CanardPoolAllocatorStatistics;
 
+/// Number of interfaces counted separately in CanardTransportStatistics. DroneCAN nodes have up to three redundant
+/// interfaces; frames of interfaces beyond this limit are only counted in the totals.
+#ifndef CANARD_STATISTICS_MAX_IFACES
+#if CANARD_MULTI_IFACE
+#define CANARD_STATISTICS_MAX_IFACES                3U
+#else
+#define CANARD_STATISTICS_MAX_IFACES                1U
+#endif
+#endif
+
+/**
+ * What became of a frame that is removed from the TX queue, see canardRemoveTxQueueFrame().
+ */
+typedef enum
+{
+    CanardTxFrameTransmitted,               ///< Accepted by the driver, counted in frames_tx
+    CanardTxFrameDropped,                   ///< Rejected by the driver, counted in tx_dropped and the interface errors
+    CanardTxFrameHandedOff                  ///< Passed on to another queue, not counted; the caller counts the outcome
+} CanardTxFrameOutcome;
+
+/**
+ * Frame counters of one CAN interface, see CanardTransportStatistics.
+ */
+typedef struct
+{
+    uint64_t frames_rx;                     ///< Frames passed to canardHandleRxFrame()
+    uint64_t frames_tx;                     ///< Frames removed from the TX queue after transmission
+    uint64_t errors;                        ///< Received frames that broke a transfer (see CanardTransportStatistics)
+                                            ///< and frames dropped from the TX queue without being sent
+} CanardIfaceStatistics;
+
+/**
+ * Transport layer counters of an instance, e.g. for a uavcan.protocol.GetTransportStats server.
+ * Transfer errors are frames that were rejected because a transfer was corrupted or could not be stored: missed
+ * start, wrong toggle, unexpected transfer ID, short frame, bad CRC and out of memory. Frames that are not addressed
+ * to this node, not wanted by the application or not DroneCAN frames at all are counted in rx_errors only.
+ */
+typedef struct
+{
+    uint64_t frames_rx;                     ///< Frames passed to canardHandleRxFrame()
+    uint64_t frames_tx;                     ///< Frames removed from the TX queue after transmission, once per interface
+    uint64_t transfers_rx;                  ///< Transfers delivered to the application
+    uint64_t transfers_tx;                  ///< Transfers added to the TX queue
+    uint64_t transfer_errors;               ///< Received frames that broke a transfer, see above
+    uint64_t rx_errors[CANARD_RX_ERROR_COUNT];  ///< Rejected frames by error, index = CANARD_ERROR_RX_* code minus
+                                                ///< CANARD_ERROR_RX_INCOMPATIBLE_PACKET
+    uint64_t rx_out_of_memory;              ///< Received frames dropped because the pool was exhausted
+    uint64_t tx_dropped;                    ///< Frames dropped from the TX queue without being sent, once per interface
+    CanardIfaceStatistics iface[CANARD_STATISTICS_MAX_IFACES];  ///< Per interface, by iface_id
+} CanardTransportStatistics;
+
 /**
  * INTERNAL DEFINITION, DO NOT USE DIRECTLY.
  * Buffer block for received data.
@@ -340,9 +456,17 @@ typedef struct
     // user should initialize semaphore after the canardInit
     // or at first call of canard_allocate_sem_take
     void *semaphore;
+#if CANARD_ENABLE_LOCKFREE_ALLOCATOR
+    /// Index of the first free block plus one in the lower 32 bits, 0 if the pool is exhausted.
+    /// The upper 32 bits count the updates, so a thread that was preempted between reading the head and swapping it
+    /// cannot install a link that has changed in the meantime (ABA problem).
+    uint64_t free_head;
+#else
     CanardPoolAllocatorBlock* free_list;
+#endif
     CanardPoolAllocatorStatistics statistics;
     void *arena;
+    uint16_t block_size;                    ///< Size of the blocks of this pool in bytes
 } CanardPoolAllocator;
 
 
@@ -370,6 +494,25 @@ struct CanardRxState
 };
 CANARD_STATIC_ASSERT(offsetof(CanardRxState, buffer_head) <= 27, "Invalid memory layout");
 CANARD_STATIC_ASSERT(CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE >= 5, "Invalid memory layout");
+CANARD_STATIC_ASSERT((CANARD_RX_BLOCK_SIZE % 8U) == 0, "TX pools carved after RX blocks must stay aligned");
+CANARD_STATIC_ASSERT(CANARD_TX_POOL_PERCENT <= 100U, "CANARD_TX_POOL_PERCENT is a percentage");
+CANARD_STATIC_ASSERT((CANARD_CRC_SIGNATURE_CACHE_SIZE & (CANARD_CRC_SIGNATURE_CACHE_SIZE - 1U)) == 0,
+                     "CANARD_CRC_SIGNATURE_CACHE_SIZE must be a power of two");
+CANARD_STATIC_ASSERT((CANARD_RX_STATE_HASH_BUCKETS & (CANARD_RX_STATE_HASH_BUCKETS - 1U)) == 0,
+                     "CANARD_RX_STATE_HASH_BUCKETS must be a power of two");
+CANARD_STATIC_ASSERT((CANARD_RX_TIMER_WHEEL_SLOTS & (CANARD_RX_TIMER_WHEEL_SLOTS - 1U)) == 0,
+                     "CANARD_RX_TIMER_WHEEL_SLOTS must be a power of two");
+
+/**
+ * INTERNAL DEFINITION, DO NOT USE DIRECTLY.
+ * Transfer CRC value after the data type signature has been hashed in.
+ */
+typedef struct
+{
+    uint64_t data_type_signature;
+    uint16_t crc;
+    bool valid;
+} CanardCrcSignatureCacheEntry;
 
 /**
  * This is the core structure that keeps all of the states and allocated resources of the library instance.
@@ -382,13 +525,29 @@ struct CanardInstance
     CanardShouldAcceptTransfer should_accept;       ///< Function to decide whether the application wants this transfer
     CanardOnTransferReception on_reception;         ///< Function the library calls after RX transfer is complete
 
-    CanardPoolAllocator allocator;                  ///< Pool allocator
+    CanardPoolAllocator allocator;                  ///< Pool allocator for RX states and RX payload blocks
+    CanardPoolAllocator tx_allocator;               ///< TX queue item pool, see canardSetTxArena()
+    void* pool_arena;                               ///< The canardInit() arena without the RX state hash buckets
+    size_t pool_arena_size;                         ///< Size of the above, in bytes
 
-    CanardRxState* rx_states;                       ///< RX transfer states
-    CanardTxQueueItem* tx_queue;                    ///< TX frames awaiting transmission
+    canard_buffer_idx_t* rx_states;                 ///< RX transfer state hash buckets, located in the arena
+    uint32_t rx_timer_wheel[CANARD_RX_TIMER_WHEEL_SLOTS];   ///< RX states by expiry, RX block index + 1, 0 if empty
+    uint32_t* rx_timer_wheel_links;                 ///< Next RX state in the same slot for every RX block, in the arena
+    uint64_t rx_timer_wheel_usec;                   ///< Start of the next timer wheel slot to expire
+    CanardTxQueueItem* tx_queue;                    ///< TX frames awaiting transmission, ordered by CAN ID
+    CanardTxQueueItem* tx_queue_tails[CANARD_TRANSFER_PRIORITY_LEVELS];    ///< Last queued frame of every priority
+    uint32_t tx_queue_levels;                       ///< Bitmap of priority levels that have frames queued
+    uint32_t tx_queue_length;                       ///< Number of frames in the TX queue
+
+    CanardCrcSignatureCacheEntry crc_signature_cache[CANARD_CRC_SIGNATURE_CACHE_SIZE];  ///< Cached CRC seeds
+
+    uint8_t* rx_reassembly_buffer;                  ///< Contiguous multi-frame payload storage; NULL if disabled
+    uint16_t rx_reassembly_buffer_size;             ///< Size of the above, in bytes
 
     void* user_reference;                           ///< User pointer that can link this instance with other objects
 
+    CanardTransportStatistics statistics;           ///< Frame, transfer and error counters
+
 #if CANARD_ENABLE_TAO_OPTION
     bool tao_disabled;                              ///< True if TAO is disabled
 #endif
@@ -421,6 +580,10 @@ struct CanardRxTransfer
      * For single-frame transfers, middle and tail will be NULL, and the head will point at first byte
      * of the payload of the CAN frame.
      *
+     * If a reassembly buffer is configured (see canardSetRxReassemblyBuffer()), multi-frame transfers that fit
+     * into it are delivered the same way as single-frame transfers: the head points at the whole payload stored
+     * contiguously in the reassembly buffer, and middle and tail are NULL.
+     *
      * In simple cases it should be possible to get data directly from the head and/or tail pointers.
      * Otherwise it is advised to use canardDecodeScalar().
      */
@@ -458,6 +621,16 @@ struct CanardRxTransfer
  * Typically, size of the memory pool should not be less than 1K, although it depends on the application. The
  * recommended way to detect the required pool size is to measure the peak pool usage after a stress-test. Refer to
  * the function canardGetPoolAllocatorStatistics().
+ *
+ * The beginning of the arena is reserved for the RX transfer state hash buckets (see CANARD_RX_STATE_HASH_BUCKETS);
+ * the rest of it is used by the block allocator, at CANARD_RX_BLOCK_SIZE + 4 bytes per RX block including its timer
+ * wheel link (see CANARD_RX_TIMER_WHEEL_SLOTS). The pool is limited to the blocks whose byte offsets fit in 32 bits,
+ * i.e. 4 GiB, which leaves room for hundreds of thousands of concurrent transfers on large nodes such as gateways.
+ *
+ * RX states and RX payload are stored in CANARD_RX_BLOCK_SIZE blocks and TX queue items in CANARD_MEM_BLOCK_SIZE
+ * blocks. If the two sizes are equal, they share one pool. Otherwise, e.g. with CAN FD, where a TX item is four times
+ * the size of an RX block, each size has its own pool with its own free list and statistics, and
+ * CANARD_TX_POOL_PERCENT of the arena goes to the TX pool unless canardSetTxArena() provides a separate one.
  */
 void canardInit(CanardInstance* out_ins,                    ///< Uninitialized library instance
                 void* mem_arena,                            ///< Raw memory chunk used for dynamic allocation
@@ -480,6 +653,21 @@ void* canardGetUserReference(const CanardInstance* ins);
 void canardSetLocalNodeID(CanardInstance* ins,
                           uint8_t self_node_id);
 
+/**
+ * Enables contiguous delivery of multi-frame transfers.
+ * When enabled, the payload of a completed multi-frame transfer is gathered into the provided buffer before the
+ * reception callback is invoked, and the pool blocks it occupied are released at once. The transfer is then
+ * delivered like a single-frame transfer, so canardDecodeScalar() never has to walk the block chain.
+ * Transfers whose payload does not fit into the buffer are delivered scattered, as usual.
+ *
+ * A buffer of CANARD_MAX_TRANSFER_PAYLOAD_LEN bytes accommodates any transfer. The buffer is overwritten by every
+ * multi-frame transfer, so it must not be accessed after the reception callback returns.
+ * Pass NULL to disable this mode, which is the default.
+ */
+void canardSetRxReassemblyBuffer(CanardInstance* ins,
+                                 void* buffer,
+                                 uint16_t buffer_size);
+
 /**
  * Returns node ID of the local node.
  * Returns zero (broadcast) if the node ID is not set, i.e. if the local node is anonymous.
@@ -589,6 +777,53 @@ int16_t canardRequestOrRespond(CanardInstance* ins,             ///< Library ins
  */
 CanardCANFrame* canardPeekTxQueue(const CanardInstance* ins);
 
+/**
+ * Collects pointers to up to max_frames frames from the top of the TX queue, in transmission order.
+ * Returns the number of frames collected, zero if the TX queue is empty.
+ * This allows the application to hand several frames to the driver at once. Afterwards canardPopTxQueue() must be
+ * called once for every frame that has been processed, starting from the first one. The same restrictions as for
+ * canardPeekTxQueue() apply.
+ */
+uint16_t canardPeekTxQueueFrames(const CanardInstance* ins,
+                                 const CanardCANFrame** out_frames,
+                                 uint16_t max_frames);
+
+#if CANARD_MULTI_IFACE
+/**
+ * Same as canardPeekTxQueueFrames(), but only collects the frames that still have to be sent on the given interface,
+ * i.e. the frames whose iface_mask has bit iface_id set.
+ * Afterwards canardPopTxQueueFramesForIface() must be called with the number of frames that have been processed.
+ */
+uint16_t canardPeekTxQueueFramesForIface(const CanardInstance* ins,
+                                         uint8_t iface_id,
+                                         const CanardCANFrame** out_frames,
+                                         uint16_t max_frames);
+
+/**
+ * Marks the first frame_count frames returned by canardPeekTxQueueFramesForIface() as processed on the given
+ * interface by clearing bit iface_id of their iface_mask. Frames that have been processed on all of their interfaces
+ * are removed from the TX queue.
+ */
+void canardPopTxQueueFramesForIface(CanardInstance* ins,
+                                    uint8_t iface_id,
+                                    uint16_t frame_count);
+
+/**
+ * Same as canardPopTxQueueFramesForIface(), but the frames are counted in the transport statistics according to the
+ * given outcome. canardPopTxQueueFramesForIface() counts them as transmitted.
+ */
+void canardRemoveTxQueueFramesForIface(CanardInstance* ins,
+                                       uint8_t iface_id,
+                                       uint16_t frame_count,
+                                       CanardTxFrameOutcome outcome);
+#endif
+
+/**
+ * Returns the number of frames in the TX queue.
+ * The application can use this to monitor the TX backlog, e.g. while the bus is saturated or in bus-off state.
+ */
+uint32_t canardGetTxQueueLength(const CanardInstance* ins);
+
 /**
  * Returns the timeout for the frame on top of TX queue.
  * Returns zero if the TX queue is empty.
@@ -606,20 +841,47 @@ uint64_t canardPeekTxQueueDeadline(const CanardInstance* ins);
  */
 void canardPopTxQueue(CanardInstance* ins);
 
+/**
+ * Same as canardPopTxQueue(), but the frame is counted in the transport statistics according to the given outcome,
+ * e.g. CanardTxFrameDropped for a frame the driver refused to send. canardPopTxQueue() counts it as transmitted.
+ */
+void canardRemoveTxQueueFrame(CanardInstance* ins,
+                              CanardTxFrameOutcome outcome);
+
 /**
  * Processes a received CAN frame with a timestamp.
  * The application will call this function when it receives a new frame from the CAN bus.
  *
- * Return value will report any errors in decoding packets.
+ * Return value will report any errors in decoding packets. Every outcome is also counted in the instance's
+ * transport statistics, see canardGetTransportStatistics().
  */
 int16_t canardHandleRxFrame(CanardInstance* ins,
                             const CanardCANFrame* frame,
                             uint64_t timestamp_usec);
 
 /**
- * Traverses the list of transfers and removes those that were last updated more than timeout_usec microseconds ago.
- * This function must be invoked by the application periodically, about once a second.
+ * Processes an array of received CAN frames, in order; timestamps_usec holds the timestamp of every frame.
+ * This is equivalent to calling canardHandleRxFrame() for every frame.
+ *
+ * Returns the number of frames that were processed without errors. Frames of transfers that the application does not
+ * want are counted as errors, so the return value is informational only.
+ */
+uint16_t canardHandleRxFrames(CanardInstance* ins,
+                              const CanardCANFrame* frames,
+                              const uint64_t* timestamps_usec,
+                              uint16_t frame_count);
+
+/**
+ * Removes the RX transfer states that were last updated more than two seconds ago, together with their partially
+ * received payload.
+ * This function must be invoked by the application periodically, at least about once a second.
  * Also refer to the constant CANARD_RECOMMENDED_STALE_TRANSFER_CLEANUP_INTERVAL_USEC.
+ *
+ * RX states are kept in a hashed timer wheel by expiry time, so a call only visits the wheel slots that have elapsed
+ * since the previous call and the states in them. States that received a new transfer since they were scheduled are
+ * moved to the slot of their new expiry time at that point. This makes it cheap to call the function often, e.g.
+ * every CANARD_RX_TIMER_WHEEL_TICK_USEC, which also frees stale states sooner.
+ * With deadlines or several interfaces, the whole TX queue is additionally scanned for expired frames.
  */
 void canardCleanupStaleTransfers(CanardInstance* ins,
                                  uint64_t current_time_usec);
@@ -700,9 +962,38 @@ void canardReleaseRxTransferPayload(CanardInstance* ins,
  * Returns a copy of the pool allocator usage statistics.
  * Refer to the type CanardPoolAllocatorStatistics.
  * Use this function to determine worst case memory needs of your application.
+ * If TX queue items have their own pool (see canardInit()), only the RX blocks are counted here.
  */
 CanardPoolAllocatorStatistics canardGetPoolAllocatorStatistics(CanardInstance* ins);
 
+/**
+ * Returns a copy of the frame, transfer and error counters of the instance.
+ * Refer to the type CanardTransportStatistics.
+ */
+CanardTransportStatistics canardGetTransportStatistics(const CanardInstance* ins);
+
+/**
+ * Gives the TX queue its own memory arena, separate from the one passed to canardInit().
+ * By default TX queue items are allocated from the same pool as the RX states and reassembly blocks, so a TX backlog
+ * on a congested bus can use up the pool and make reception fail. With a separate arena the backlog is limited by the
+ * TX arena only, and the canardInit() arena is reserved for reception.
+ *
+ * Must be called while the TX queue is empty, otherwise -CANARD_ERROR_INVALID_ARGUMENT is returned. If RX and TX
+ * blocks differ in size, the RX pool is laid out again to include or exclude the TX share of the canardInit() arena,
+ * so no transfer may be in the middle of reception either.
+ * Passing a NULL arena or one smaller than a block makes the TX queue share the canardInit() arena again.
+ * The arena must outlive the instance or the next call of this function.
+ */
+int16_t canardSetTxArena(CanardInstance* ins,
+                         void* mem_arena,
+                         size_t mem_arena_size);
+
+/**
+ * Returns a copy of the usage statistics of the pool that TX queue items are allocated from.
+ * This is the canardSetTxArena() pool if one was set, otherwise the same as canardGetPoolAllocatorStatistics().
+ */
+CanardPoolAllocatorStatistics canardGetTxPoolAllocatorStatistics(CanardInstance* ins);
+
 /**
  * Float16 marshaling helpers.
  * These functions convert between the native float and 16-bit float.
@@ -713,17 +1004,26 @@ CanardPoolAllocatorStatistics canardGetPoolAllocatorStatistics(CanardInstance* i
 uint16_t canardConvertNativeFloatToFloat16(float value);
 float canardConvertFloat16ToNativeFloat(uint16_t value);
 
+/**
+ * Batch versions of the float16 marshaling helpers; convert count consecutive values.
+ * On x86 CPUs that support F16C the conversion is done in hardware, eight values at a time; the choice is made at
+ * run time, so the same binary runs on CPUs without F16C. The results are identical to the scalar helpers on every
+ * CPU: groups of eight that contain an exact rounding tie, a result below the smallest normal float16 value or a NaN
+ * are converted in software, because the hardware rounds ties to even and quiets signaling NaNs.
+ */
+void canardConvertFloat16ArrayToNativeFloat(const uint16_t* values,
+                                            float* out_values,
+                                            size_t count);
+void canardConvertNativeFloatArrayToFloat16(const float* values,
+                                            uint16_t* out_values,
+                                            size_t count);
+
 uint16_t extractDataType(uint32_t id);
 CanardTransferType extractTransferType(uint32_t id);
 
 /// Abort the build if the current platform is not supported.
-#if CANARD_ENABLE_CANFD
-CANARD_STATIC_ASSERT(((uint32_t)CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE) < 128,
+CANARD_STATIC_ASSERT(((uint32_t)CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE) < CANARD_RX_BLOCK_SIZE,
                      "Please define CANARD_64_BIT=1 for 64 bit builds");
-#else
-CANARD_STATIC_ASSERT(((uint32_t)CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE) < 32,
-                     "Please define CANARD_64_BIT=1 for 64 bit builds");
-#endif
 
 #if CANARD_ALLOCATE_SEM
 // user implemented functions for taking and freeing semaphores
@@ -85,6 +85,34 @@ extern "C" {
 # define CANARD_SIZEOF_FLOAT   4
 #endif
 
+/*
+ * Scalars that lie within the contiguous part of a payload are marshaled with a single bounded 64-bit load/store
+ * instead of the generic bit copy. This relies on the native byte order being known at compile time to be
+ * little-endian, which matches the byte order of the serialized representation.
+ */
+#ifndef CANARD_ENABLE_FAST_SCALAR_CODEC
+# if !WORD_ADDRESSING_IS_16BITS && defined(__GNUC__) && defined(__BYTE_ORDER__) && \
+     (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#  define CANARD_ENABLE_FAST_SCALAR_CODEC 1
+# else
+#  define CANARD_ENABLE_FAST_SCALAR_CODEC 0
+# endif
+#endif
+
+/*
+ * Hardware float16 conversion on x86. The F16C code is compiled with a function-level target attribute and is
+ * only invoked after a run-time CPU feature check, so the rest of the library is built for the baseline ISA.
+ */
+#ifndef CANARD_ENABLE_F16C
+# if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define CANARD_ENABLE_F16C 1
+# else
+#  define CANARD_ENABLE_F16C 0
+# endif
+#endif
+
+CANARD_INTERNAL uint32_t rxStateBucket(uint32_t transfer_descriptor);
+
 CANARD_INTERNAL CanardRxState* traverseRxStates(CanardInstance* ins,
                                                 uint32_t transfer_descriptor);
 
@@ -102,11 +130,34 @@ CANARD_INTERNAL int16_t bufferBlockPushBytes(CanardPoolAllocator* allocator,
                                              const uint8_t* data,
                                              uint8_t data_len);
 
+CANARD_INTERNAL size_t lastBufferBlockFill(const CanardRxState* state);
+
+CANARD_INTERNAL CanardBufferBlock* appendBufferBlock(CanardPoolAllocator* allocator,
+                                                     CanardRxState* state);
+
+CANARD_INTERNAL CanardBufferBlock* detachBufferBlocks(CanardPoolAllocator* allocator,
+                                                      CanardRxState* state);
+
+/**
+ * Copies the payload accumulated in the RX state followed by the given tail bytes into a contiguous buffer.
+ */
+CANARD_INTERNAL void gatherStatePayload(CanardPoolAllocator* allocator,
+                                        const CanardRxState* state,
+                                        const uint8_t* tail,
+                                        uint8_t tail_len,
+                                        uint8_t* output);
+
 CANARD_INTERNAL CanardBufferBlock* createBufferBlock(CanardPoolAllocator* allocator);
 
 CANARD_INTERNAL void pushTxQueue(CanardInstance* ins,
                                  CanardTxQueueItem* item);
 
+CANARD_INTERNAL void removeTxQueueItem(CanardInstance* ins,
+                                       CanardTxQueueItem* previous,
+                                       CanardTxQueueItem* item);
+
+CANARD_INTERNAL uint8_t highestSetBit(uint32_t value);
+
 CANARD_INTERNAL bool isPriorityHigher(uint32_t id,
                                       uint32_t rhs);
 
@@ -114,6 +165,26 @@ CANARD_INTERNAL CanardTxQueueItem* createTxItem(CanardPoolAllocator* allocator);
 
 CANARD_INTERNAL void prepareForNextTransfer(CanardRxState* state);
 
+/**
+ * canardHandleRxFrame() without the statistics.
+ */
+CANARD_INTERNAL int16_t handleRxFrame(CanardInstance* ins,
+                                      const CanardCANFrame* frame,
+                                      uint64_t timestamp_usec);
+
+/**
+ * Counts the outcome of a received frame in the transport statistics.
+ */
+CANARD_INTERNAL void countRxFrame(CanardInstance* ins, uint8_t iface_id, int16_t result);
+
+/**
+ * Counts frames removed from the TX queue of the given interface according to their outcome.
+ */
+CANARD_INTERNAL void countTxFrames(CanardInstance* ins,
+                                   uint8_t iface_id,
+                                   uint16_t frame_count,
+                                   CanardTxFrameOutcome outcome);
+
 CANARD_INTERNAL int16_t computeTransferIDForwardDistance(uint8_t a,
                                                          uint8_t b);
 
@@ -148,8 +219,41 @@ CANARD_INTERNAL int16_t descatterTransferPayload(const CanardRxTransfer* transfe
 
 CANARD_INTERNAL bool isBigEndian(void);
 
+#if CANARD_ENABLE_FAST_SCALAR_CODEC
+/**
+ * Fast path of canardDecodeScalar(). The field must satisfy (bit_offset % 8 + bit_length) <= 64 and
+ * lie entirely within the buffer.
+ */
+CANARD_INTERNAL void decodeContiguousScalar(const uint8_t* bytes,
+                                            uint32_t bit_offset,
+                                            uint8_t bit_length,
+                                            bool value_is_signed,
+                                            void* out_value);
+
+/**
+ * Fast path of canardEncodeScalar(). Same constraints as decodeContiguousScalar().
+ * Only the bytes spanned by the field are accessed; bits outside of the field are preserved.
+ */
+CANARD_INTERNAL void encodeContiguousScalar(uint8_t* bytes,
+                                            uint32_t bit_offset,
+                                            uint8_t bit_length,
+                                            const void* value);
+#endif
+
 CANARD_INTERNAL void swapByteOrder(void* data, unsigned size);
 
+#if CANARD_ENABLE_F16C
+CANARD_INTERNAL bool hasHardwareFloat16(void);
+
+CANARD_INTERNAL void convertFloat16ArrayToNativeFloatF16C(const uint16_t* values,
+                                                          float* out_values,
+                                                          size_t count);
+
+CANARD_INTERNAL void convertNativeFloatArrayToFloat16F16C(const float* values,
+                                                          uint16_t* out_values,
+                                                          size_t count);
+#endif
+
 /*
  * Transfer CRC
  */
@@ -163,16 +267,61 @@ CANARD_INTERNAL uint16_t crcAdd(uint16_t crc_val,
                                 const uint8_t* bytes,
                                 size_t len);
 
+/**
+ * Returns the initial transfer CRC with the data type signature hashed in.
+ * Recently used signatures are served from the per-instance cache.
+ */
+CANARD_INTERNAL uint16_t crcSignatureSeed(CanardInstance* ins,
+                                          uint64_t data_type_signature);
+
 /**
  * Inits a memory allocator.
  *
  * @param [in] allocator The memory allocator to initialize.
  * @param [in] buf The buffer used by the memory allocator.
- * @param [in] buf_len The number of blocks in buf.
+ * @param [in] buf_size The size of buf in bytes.
+ * @param [in] block_size The size of the blocks to divide buf into.
  */
 CANARD_INTERNAL void initPoolAllocator(CanardPoolAllocator* allocator,
                                        void *buf,
-                                       uint16_t buf_len);
+                                       size_t buf_size,
+                                       uint16_t block_size);
+
+/**
+ * Returns a consistent copy of the statistics of the given pool allocator.
+ */
+CANARD_INTERNAL CanardPoolAllocatorStatistics readPoolAllocatorStatistics(const CanardPoolAllocator* allocator);
+
+/**
+ * Returns the pool allocator that TX queue items come from.
+ */
+CANARD_INTERNAL CanardPoolAllocator* txAllocator(CanardInstance* ins);
+
+/**
+ * Lays out the RX pool over the canardInit() arena and the TX pool over the given arena, or over a share of the
+ * canardInit() arena if tx_arena is NULL and RX and TX blocks differ in size.
+ */
+CANARD_INTERNAL void initPools(CanardInstance* ins, void* tx_arena, size_t tx_arena_size);
+
+/**
+ * Sets up the TX pool over the given arena; a NULL or too small arena leaves it empty.
+ */
+CANARD_INTERNAL void initTxPool(CanardInstance* ins, void* tx_arena, size_t tx_arena_size);
+
+/**
+ * Puts the RX state into the timer wheel slot of its expiry time, or of the next slot if that is already past.
+ */
+CANARD_INTERNAL void scheduleRxState(CanardInstance* ins, CanardRxState* state);
+
+/**
+ * Processes the timer wheel slots that have elapsed up to the given time, removing expired RX states.
+ */
+CANARD_INTERNAL void expireRxStates(CanardInstance* ins, uint64_t current_time_usec);
+
+/**
+ * Unlinks the RX state from its hash bucket and frees it together with its payload.
+ */
+CANARD_INTERNAL void removeRxState(CanardInstance* ins, CanardRxState* state);
 
 /**
  * Allocates a block from the given pool allocator.
@@ -185,7 +334,8 @@ CANARD_INTERNAL void* allocateBlock(CanardPoolAllocator* allocator);
 CANARD_INTERNAL void freeBlock(CanardPoolAllocator* allocator,
                                void* p);
 
-CANARD_INTERNAL uint16_t calculateCRC(const CanardTxTransfer* transfer_object);
+CANARD_INTERNAL uint16_t calculateCRC(CanardInstance* ins,
+                                      const CanardTxTransfer* transfer_object);
 
 CANARD_INTERNAL CanardBufferBlock *canardBufferFromIdx(CanardPoolAllocator* allocator, canard_buffer_idx_t idx);
 
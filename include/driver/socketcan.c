@@ -16,15 +16,22 @@
 #include <string.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <sys/socket.h>
 #ifdef __NuttX__
 #include <nuttx/can.h>
 #include <netpacket/can.h>
 #else
 #include <linux/can.h>
 #include <linux/can/raw.h>
+#include <linux/net_tstamp.h>
 #endif
 #include <errno.h>
 #include <stdlib.h>
+#include <time.h>
+
+#ifndef CAN_RAW_FILTER_MAX
+# define CAN_RAW_FILTER_MAX 512                             // Older kernel headers do not export the limit
+#endif
 
 /// Returns the current errno as negated int16_t
 static int16_t getErrorCode()
@@ -84,13 +91,14 @@ int16_t socketcanInit(SocketCANInstance* out_ins, const char* can_iface_name)
 #if CANARD_ENABLE_CANFD
     if(canfd)
     {
-    	const int on = 1;
+        const int on = 1;
         if(setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &on, sizeof(on)) < 0)
         {
             goto fail1;
         }
     }
     out_ins->canfd = canfd;
+    out_ins->canfd_brs = canfd;
 #endif
 
     const int bind_result = bind(fd, (struct sockaddr*)&addr, sizeof(addr));
@@ -100,6 +108,8 @@ int16_t socketcanInit(SocketCANInstance* out_ins, const char* can_iface_name)
     }
 
     out_ins->fd = fd;
+    out_ins->iface_id = 0;
+    out_ins->timestamping = SocketCANTimestampNone;
     return 0;
 
 fail1:
@@ -108,6 +118,56 @@ fail0:
     return getErrorCode();
 }
 
+int16_t socketcanSetTimestampMode(SocketCANInstance* ins, SocketCANTimestampMode mode)
+{
+#ifdef __NuttX__
+    if (mode != SocketCANTimestampNone)
+    {
+        return -ENOTSUP;
+    }
+#else
+    int flags = 0;
+    if (mode != SocketCANTimestampNone)
+    {
+        flags |= SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    }
+    if (mode == SocketCANTimestampHardware)
+    {
+        flags |= SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+    }
+    if (setsockopt(ins->fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) < 0)
+    {
+        return getErrorCode();
+    }
+#endif
+    ins->timestamping = (uint8_t)mode;
+    return 0;
+}
+
+// SocketCANFilter has the layout of struct can_filter, so the caller's array goes to the kernel as is
+CANARD_STATIC_ASSERT(sizeof(SocketCANFilter) == sizeof(struct can_filter), "SocketCANFilter layout");
+CANARD_STATIC_ASSERT(offsetof(SocketCANFilter, id) == offsetof(struct can_filter, can_id), "SocketCANFilter layout");
+CANARD_STATIC_ASSERT(offsetof(SocketCANFilter, mask) == offsetof(struct can_filter, can_mask), "SocketCANFilter layout");
+
+int16_t socketcanSetFilters(SocketCANInstance* ins, const SocketCANFilter* filters, uint16_t filter_count)
+{
+    if (filters == NULL)
+    {
+        const struct can_filter accept_all = { .can_id = 0, .can_mask = 0 };
+        return (int16_t)((setsockopt(ins->fd, SOL_CAN_RAW, CAN_RAW_FILTER, &accept_all, sizeof(accept_all)) == 0) ?
+                         0 : getErrorCode());
+    }
+
+    if (filter_count > CAN_RAW_FILTER_MAX)
+    {
+        return -EINVAL;
+    }
+
+    const int result = setsockopt(ins->fd, SOL_CAN_RAW, CAN_RAW_FILTER, filters,
+                                  (socklen_t)(sizeof(SocketCANFilter) * filter_count));
+    return (int16_t)((result == 0) ? 0 : getErrorCode());
+}
+
 int16_t socketcanClose(SocketCANInstance* ins)
 {
     const int close_result = close(ins->fd);
@@ -115,6 +175,47 @@ int16_t socketcanClose(SocketCANInstance* ins)
     return (int16_t)((close_result == 0) ? 0 : getErrorCode());
 }
 
+/// Kernel representation of an outgoing frame
+typedef union
+{
+    struct can_frame can;
+#if CANARD_ENABLE_CANFD
+    struct canfd_frame canfd;
+#endif
+} SocketCANTxFrame;
+
+/*
+ * CanardCANFrame.id carries the frame format flags at the same positions as the kernel can_id, so the ID is passed
+ * through unchanged in both directions.
+ */
+CANARD_STATIC_ASSERT(CANARD_CAN_FRAME_EFF == CAN_EFF_FLAG, "Unexpected frame format flag layout");
+CANARD_STATIC_ASSERT(CANARD_CAN_FRAME_RTR == CAN_RTR_FLAG, "Unexpected frame format flag layout");
+CANARD_STATIC_ASSERT(CANARD_CAN_FRAME_ERR == CAN_ERR_FLAG, "Unexpected frame format flag layout");
+
+/// Converts the frame into its kernel representation, returns the number of bytes to write
+static size_t encodeTxFrame(const SocketCANInstance* ins, const CanardCANFrame* frame, SocketCANTxFrame* out_frame)
+{
+#if CANARD_ENABLE_CANFD
+    if (frame->canfd)
+    {
+        memset(&out_frame->canfd, 0, sizeof(out_frame->canfd));
+        out_frame->canfd.can_id = frame->id;
+        out_frame->canfd.len = frame->data_len;
+        // ESI is left clear, it is set by the controller itself while it is error passive
+        out_frame->canfd.flags = ins->canfd_brs ? CANFD_BRS : 0;
+        memcpy(out_frame->canfd.data, frame->data, frame->data_len);
+        return sizeof(out_frame->canfd);
+    }
+#else
+    (void)ins;
+#endif
+    memset(&out_frame->can, 0, sizeof(out_frame->can));
+    out_frame->can.can_id = frame->id;
+    out_frame->can.can_dlc = frame->data_len;
+    memcpy(out_frame->can.data, frame->data, frame->data_len);
+    return sizeof(out_frame->can);
+}
+
 int16_t socketcanTransmit(SocketCANInstance* ins, const CanardCANFrame* frame, int32_t timeout_msec)
 {
     struct pollfd fds;
@@ -136,46 +237,153 @@ int16_t socketcanTransmit(SocketCANInstance* ins, const CanardCANFrame* frame, i
         return -EIO;
     }
 
-#if CANARD_ENABLE_CANFD
-    if(frame->canfd)
+    SocketCANTxFrame transmit_frame;
+    const size_t frame_size = encodeTxFrame(ins, frame, &transmit_frame);
+    const ssize_t nbytes = write(ins->fd, &transmit_frame, frame_size);
+
+    if (nbytes < 0)
+    {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ENOBUFS))
+        {
+            return 0;                                       // The socket buffer or the device queue is full
+        }
+        return getErrorCode();
+    }
+    if ((size_t)nbytes != frame_size)
     {
-        struct canfd_frame transmit_frame;
-        memset(&transmit_frame, 0, sizeof(transmit_frame));
-        transmit_frame.can_id = frame->id;                  // TODO: Map flags properly
-        transmit_frame.len = frame->data_len;
-        memcpy(transmit_frame.data, frame->data, frame->data_len);
-        const ssize_t nbytes = write(ins->fd, &transmit_frame, sizeof(transmit_frame));
+        return -EIO;
+    }
 
-        if (nbytes < 0)
+    return 1;
+}
+
+int16_t socketcanTransmitBatch(SocketCANInstance* ins,
+                               const CanardCANFrame* const* frames,
+                               uint16_t frame_count,
+                               int32_t timeout_msec)
+{
+    if (timeout_msec != 0)
+    {
+        struct pollfd fds;
+        memset(&fds, 0, sizeof(fds));
+        fds.fd = ins->fd;
+        fds.events |= POLLOUT;
+
+        const int poll_result = poll(&fds, 1, timeout_msec);
+        if (poll_result < 0)
         {
             return getErrorCode();
         }
-        if ((size_t)nbytes != sizeof(transmit_frame))
+        if (poll_result == 0)
+        {
+            return 0;
+        }
+        if (((uint32_t)fds.revents & (uint32_t)POLLOUT) == 0)
         {
             return -EIO;
         }
     }
-    else
+
+    if (frame_count > INT16_MAX)
+    {
+        frame_count = INT16_MAX;
+    }
+
+    SocketCANTxFrame tx_frames[SOCKETCAN_TX_BATCH_MAX];
+    struct iovec iovecs[SOCKETCAN_TX_BATCH_MAX];
+#ifndef __NuttX__
+    struct mmsghdr messages[SOCKETCAN_TX_BATCH_MAX];
+    memset(messages, 0, sizeof(messages));
 #endif
+
+    uint16_t sent = 0;
+    while (sent < frame_count)
     {
-        struct can_frame transmit_frame;
-        memset(&transmit_frame, 0, sizeof(transmit_frame));
-        transmit_frame.can_id = frame->id;                  // TODO: Map flags properly
-        transmit_frame.can_dlc = frame->data_len;
-        memcpy(transmit_frame.data, frame->data, frame->data_len);
-        const ssize_t nbytes = write(ins->fd, &transmit_frame, sizeof(transmit_frame));
+        const uint16_t chunk = (uint16_t)(((frame_count - sent) < SOCKETCAN_TX_BATCH_MAX) ?
+                                          (frame_count - sent) : SOCKETCAN_TX_BATCH_MAX);
+        for (uint16_t i = 0; i < chunk; i++)
+        {
+            iovecs[i].iov_base = &tx_frames[i];
+            iovecs[i].iov_len = encodeTxFrame(ins, frames[sent + i], &tx_frames[i]);
+        }
 
-        if (nbytes < 0)
+#ifndef __NuttX__
+        for (uint16_t i = 0; i < chunk; i++)
         {
-            return getErrorCode();
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
         }
-        if ((size_t)nbytes != sizeof(transmit_frame))
+        const int accepted = sendmmsg(ins->fd, messages, chunk, MSG_DONTWAIT);
+#else
+        int accepted = 0;                                   // No sendmmsg(), falling back to one write per frame
+        while (accepted < chunk)
         {
-            return -EIO;
+            if (write(ins->fd, iovecs[accepted].iov_base, iovecs[accepted].iov_len) < 0)
+            {
+                accepted = (accepted > 0) ? accepted : -1;
+                break;
+            }
+            accepted++;
+        }
+#endif
+        if (accepted < 0)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ENOBUFS))
+            {
+                break;                                      // The socket buffer or the device queue is full
+            }
+            return (sent > 0) ? (int16_t)sent : getErrorCode();
+        }
+
+        sent = (uint16_t)(sent + accepted);
+        if (accepted < chunk)
+        {
+            break;
         }
     }
 
-    return 1;
+    return (int16_t)sent;
+}
+
+/// Kernel representation of an incoming frame
+typedef union
+{
+    struct can_frame can;
+#if CANARD_ENABLE_CANFD
+    struct canfd_frame canfd;
+#endif
+} SocketCANRxFrame;
+
+/// Converts a frame received from the kernel, returns false if the frame is malformed
+static bool decodeRxFrame(const SocketCANRxFrame* frame, size_t frame_size, uint8_t iface_id, CanardCANFrame* out_frame)
+{
+#if CANARD_ENABLE_CANFD
+    if (frame_size == CANFD_MTU)
+    {
+        if (frame->canfd.len > CANFD_MAX_DLEN)
+        {
+            return false;
+        }
+        out_frame->id = frame->canfd.can_id;
+        out_frame->data_len = frame->canfd.len;
+        memcpy(out_frame->data, frame->canfd.data, frame->canfd.len);
+        out_frame->canfd = true;
+        out_frame->iface_id = iface_id;
+        return true;
+    }
+#endif
+    if ((frame_size != CAN_MTU) || (frame->can.can_dlc > CAN_MAX_DLEN))
+    {
+        return false;
+    }
+    out_frame->id = frame->can.can_id;
+    out_frame->data_len = frame->can.can_dlc;
+    memcpy(out_frame->data, frame->can.data, frame->can.can_dlc);
+#if CANARD_ENABLE_CANFD
+    out_frame->canfd = false;
+#endif
+    out_frame->iface_id = iface_id;
+    return true;
 }
 
 int16_t socketcanReceive(SocketCANInstance* ins, CanardCANFrame* out_frame, int32_t timeout_msec)
@@ -199,57 +407,168 @@ int16_t socketcanReceive(SocketCANInstance* ins, CanardCANFrame* out_frame, int3
         return -EIO;
     }
 
-#if CANARD_ENABLE_CANFD
-    if(ins->canfd)
+    // Classic frames arrive as CAN_MTU even if CAN FD frames are enabled on the socket
+    SocketCANRxFrame receive_frame;
+    const ssize_t nbytes = read(ins->fd, &receive_frame, sizeof(receive_frame));
+    if (nbytes < 0)
     {
-        struct canfd_frame receive_frame;
-        const ssize_t nbytes = read(ins->fd, &receive_frame, sizeof(receive_frame));
-        if (nbytes < 0)
-        {
-            return getErrorCode();
-        }
-        if ((size_t)nbytes != sizeof(receive_frame))
+        return getErrorCode();
+    }
+    if (!decodeRxFrame(&receive_frame, (size_t)nbytes, ins->iface_id, out_frame))
+    {
+        return -EIO;
+    }
+
+    return 1;
+}
+
+/// Returns the time of the specified clock in microseconds
+static uint64_t getClockUsec(clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+#ifndef __NuttX__
+/// Ancillary data buffer large enough for SCM_TIMESTAMPING, which carries three timespecs
+typedef union
+{
+    char buffer[CMSG_SPACE(sizeof(struct timespec) * 3U)];
+    struct cmsghdr align;
+} SocketCANRxControl;
+
+/**
+ * Extracts the SCM_TIMESTAMPING timestamp of a received message in microseconds, or zero if there is none.
+ * The first timespec is the software timestamp, the third one is the raw hardware timestamp.
+ */
+static uint64_t extractKernelTimestamp(struct msghdr* msg, bool prefer_hardware)
+{
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(msg); cmsg != NULL; cmsg = CMSG_NXTHDR(msg, cmsg))
+    {
+        if ((cmsg->cmsg_level != SOL_SOCKET) || (cmsg->cmsg_type != SCM_TIMESTAMPING) ||
+            (cmsg->cmsg_len < CMSG_LEN(sizeof(struct timespec) * 3U)))
         {
-            return -EIO;
+            continue;
         }
 
-        if (receive_frame.len > CANFD_MAX_DLEN)           // Appeasing Coverity Scan
+        struct timespec stamps[3];
+        memcpy(stamps, CMSG_DATA(cmsg), sizeof(stamps));
+
+        const struct timespec* stamp = &stamps[0];
+        if (prefer_hardware && ((stamps[2].tv_sec != 0) || (stamps[2].tv_nsec != 0)))
         {
-            return -EIO;
+            stamp = &stamps[2];
         }
-
-        out_frame->id = receive_frame.can_id;               // TODO: Map flags properly
-        out_frame->data_len = receive_frame.len;
-        memcpy(out_frame->data, &receive_frame.data, receive_frame.len);
+        return (uint64_t)stamp->tv_sec * 1000000ULL + (uint64_t)stamp->tv_nsec / 1000ULL;
     }
-    else
+    return 0;
+}
 #endif
+
+int16_t socketcanReceiveBatch(SocketCANInstance* ins,
+                              CanardCANFrame* out_frames,
+                              uint64_t* out_timestamps_usec,
+                              uint16_t max_frames,
+                              int32_t timeout_msec)
+{
+    if (timeout_msec != 0)
     {
-        struct can_frame receive_frame;
-        const ssize_t nbytes = read(ins->fd, &receive_frame, sizeof(receive_frame));
-        if (nbytes < 0)
+        struct pollfd fds;
+        memset(&fds, 0, sizeof(fds));
+        fds.fd = ins->fd;
+        fds.events |= POLLIN;
+
+        const int poll_result = poll(&fds, 1, timeout_msec);
+        if (poll_result < 0)
         {
             return getErrorCode();
         }
-        if ((size_t)nbytes != sizeof(receive_frame))
+        if (poll_result == 0)
+        {
+            return 0;
+        }
+        if (((uint32_t)fds.revents & (uint32_t)POLLIN) == 0)
         {
             return -EIO;
         }
+    }
+
+    if (max_frames > SOCKETCAN_RX_BATCH_MAX)
+    {
+        max_frames = SOCKETCAN_RX_BATCH_MAX;
+    }
 
-        if (receive_frame.can_dlc > CAN_MAX_DLEN)           // Appeasing Coverity Scan
+    SocketCANRxFrame rx_frames[SOCKETCAN_RX_BATCH_MAX];
+    size_t rx_frame_sizes[SOCKETCAN_RX_BATCH_MAX];
+    uint64_t rx_kernel_timestamps[SOCKETCAN_RX_BATCH_MAX];     // CLOCK_REALTIME, zero if not available
+#ifndef __NuttX__
+    struct iovec iovecs[SOCKETCAN_RX_BATCH_MAX];
+    struct mmsghdr messages[SOCKETCAN_RX_BATCH_MAX];
+    SocketCANRxControl controls[SOCKETCAN_RX_BATCH_MAX];
+    memset(messages, 0, sizeof(messages[0]) * max_frames);
+    for (uint16_t i = 0; i < max_frames; i++)
+    {
+        iovecs[i].iov_base = &rx_frames[i];
+        iovecs[i].iov_len = sizeof(rx_frames[i]);
+        messages[i].msg_hdr.msg_iov = &iovecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+        if (ins->timestamping != SocketCANTimestampNone)
         {
-            return -EIO;
+            messages[i].msg_hdr.msg_control = controls[i].buffer;
+            messages[i].msg_hdr.msg_controllen = sizeof(controls[i].buffer);
         }
+    }
 
-        out_frame->id = receive_frame.can_id;               // TODO: Map flags properly
-        out_frame->data_len = receive_frame.can_dlc;
-        memcpy(out_frame->data, &receive_frame.data, receive_frame.can_dlc);
+    const int received = recvmmsg(ins->fd, messages, max_frames, MSG_DONTWAIT, NULL);
+    for (int i = 0; i < received; i++)
+    {
+        rx_frame_sizes[i] = messages[i].msg_len;
+        rx_kernel_timestamps[i] = extractKernelTimestamp(&messages[i].msg_hdr,
+                                                         ins->timestamping == SocketCANTimestampHardware);
+    }
+#else
+    int received = 0;                                       // No recvmmsg(), falling back to one read per frame
+    while (received < max_frames)
+    {
+        const ssize_t nbytes = recv(ins->fd, &rx_frames[received], sizeof(rx_frames[received]), MSG_DONTWAIT);
+        if (nbytes < 0)
+        {
+            received = (received > 0) ? received : -1;
+            break;
+        }
+        rx_kernel_timestamps[received] = 0;
+        rx_frame_sizes[received++] = (size_t)nbytes;
+    }
+#endif
+    if (received < 0)
+    {
+        return ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? 0 : getErrorCode();
     }
 
-    // assume a single interface
-    out_frame->iface_id = 0;
+    // Kernel timestamps are converted to the monotonic clock through their age
+    const uint64_t monotonic_now_usec = getClockUsec(CLOCK_MONOTONIC);
+    const uint64_t realtime_now_usec = (ins->timestamping != SocketCANTimestampNone) ? getClockUsec(CLOCK_REALTIME) : 0;
 
-    return 1;
+    int16_t count = 0;
+    for (int i = 0; i < received; i++)
+    {
+        if (decodeRxFrame(&rx_frames[i], rx_frame_sizes[i], ins->iface_id, &out_frames[count]))
+        {
+            if (out_timestamps_usec != NULL)
+            {
+                uint64_t age_usec = 0;
+                if ((rx_kernel_timestamps[i] != 0) && (rx_kernel_timestamps[i] < realtime_now_usec))
+                {
+                    age_usec = realtime_now_usec - rx_kernel_timestamps[i];
+                }
+                out_timestamps_usec[count] = (age_usec < monotonic_now_usec) ? (monotonic_now_usec - age_usec) : 0;
+            }
+            count++;
+        }
+    }
+
+    return count;
 }
 
 int socketcanGetSocketFileDescriptor(const SocketCANInstance* ins)
@@ -15,12 +15,23 @@ extern "C"
 {
 #endif
 
+/// Source of the per-frame timestamps reported by socketcanReceiveBatch()
+typedef enum
+{
+    SocketCANTimestampNone = 0,         ///< Time at which the receive system call returned
+    SocketCANTimestampSoftware,         ///< Kernel software timestamp taken when the frame entered the network stack
+    SocketCANTimestampHardware          ///< Controller timestamp if the driver provides one, software otherwise
+} SocketCANTimestampMode;
+
 typedef struct
 {
     int fd;
-#ifdef CANARD_ENABLE_CANFD
-    bool canfd;
+#if CANARD_ENABLE_CANFD
+    bool canfd;                         ///< CAN FD frames can be sent and received
+    bool canfd_brs;                     ///< CAN FD frames are sent with bit rate switching, on by default
 #endif
+    uint8_t iface_id;                   ///< Reported in CanardCANFrame.iface_id of received frames, 0 after init
+    uint8_t timestamping;               ///< See SocketCANTimestampMode
 } SocketCANInstance;
 
 /**
@@ -33,6 +44,33 @@ int16_t socketcanInit(SocketCANInstance* out_ins, const char* can_iface_name, bo
 int16_t socketcanInit(SocketCANInstance* out_ins, const char* can_iface_name);
 #endif
 
+/**
+ * Enables kernel reception timestamps (SO_TIMESTAMPING) for socketcanReceiveBatch().
+ * Kernel timestamps are taken on the CLOCK_REALTIME time base; they are converted to CLOCK_MONOTONIC using the age of
+ * the frame at the time of reception, so that they are not affected by clock steps. Hardware timestamps are assumed
+ * to follow CLOCK_REALTIME, which is the case for SocketCAN drivers that synchronize their timecounter to it.
+ * Returns 0 on success, negative on error; on error the previous mode remains in effect.
+ */
+int16_t socketcanSetTimestampMode(SocketCANInstance* ins, SocketCANTimestampMode mode);
+
+/**
+ * Acceptance filter; a frame is received if (frame.id & mask) == (id & mask).
+ * Both fields use the CanardCANFrame.id layout, i.e. CANARD_CAN_FRAME_EFF etc. are valid in the mask too.
+ * The structure has the layout of struct can_filter, so an array of filters is passed to the kernel without a copy.
+ */
+typedef struct
+{
+    uint32_t id;
+    uint32_t mask;
+} SocketCANFilter;
+
+/**
+ * Installs acceptance filters in the kernel (CAN_RAW_FILTER), so that frames matching none of them are dropped
+ * before they reach user space. Pass NULL to receive all frames again.
+ * Returns 0 on success, negative on error.
+ */
+int16_t socketcanSetFilters(SocketCANInstance* ins, const SocketCANFilter* filters, uint16_t filter_count);
+
 /**
  * Deinitializes the SocketCAN instance.
  * Returns 0 on success, negative on error.
@@ -42,10 +80,29 @@ int16_t socketcanClose(SocketCANInstance* ins);
 /**
  * Transmits a CanardCANFrame to the CAN socket.
  * Use negative timeout to block infinitely.
- * Returns 1 on successful transmission, 0 on timeout, negative on error.
+ * Returns 1 on successful transmission, 0 on timeout or if the kernel queue is full, negative on error.
+ * Note that a full device queue (ENOBUFS) does not clear POLLOUT, so waiting for writability alone can spin while
+ * the interface is saturated or in bus-off state; callers should back off after a 0 result.
  */
 int16_t socketcanTransmit(SocketCANInstance* ins, const CanardCANFrame* frame, int32_t timeout_msec);
 
+/// Maximum number of frames passed to the kernel by one socketcanTransmitBatch() system call.
+#ifndef SOCKETCAN_TX_BATCH_MAX
+#define SOCKETCAN_TX_BATCH_MAX 32
+#endif
+
+/**
+ * Transmits several CanardCANFrames to the CAN socket, in order, using as few system calls as possible.
+ * The timeout applies to waiting until the socket is writable; zero timeout skips the wait entirely.
+ * Use negative timeout to block infinitely.
+ * Returns the number of frames accepted by the kernel, which is less than frame_count if the socket buffer or the
+ * device queue fills up (0 on timeout), or negative on error. The same caveat as for socketcanTransmit() applies.
+ */
+int16_t socketcanTransmitBatch(SocketCANInstance* ins,
+                               const CanardCANFrame* const* frames,
+                               uint16_t frame_count,
+                               int32_t timeout_msec);
+
 /**
  * Receives a CanardCANFrame from the CAN socket.
  * Use negative timeout to block infinitely.
@@ -53,6 +110,25 @@ int16_t socketcanTransmit(SocketCANInstance* ins, const CanardCANFrame* frame, i
  */
 int16_t socketcanReceive(SocketCANInstance* ins, CanardCANFrame* out_frame, int32_t timeout_msec);
 
+/// Maximum number of frames fetched from the kernel by one socketcanReceiveBatch() system call.
+#ifndef SOCKETCAN_RX_BATCH_MAX
+#define SOCKETCAN_RX_BATCH_MAX 32
+#endif
+
+/**
+ * Receives up to max_frames CanardCANFrames from the CAN socket using as few system calls as possible.
+ * The timeout applies to waiting for the first frame; zero timeout skips the wait entirely.
+ * Use negative timeout to block infinitely.
+ * If out_timestamps_usec is not NULL, it receives the reception time of every frame (CLOCK_MONOTONIC, microseconds).
+ * Refer to socketcanSetTimestampMode() for the source of the timestamps.
+ * Returns the number of frames received, 0 on timeout or if no frames are pending, negative on error.
+ */
+int16_t socketcanReceiveBatch(SocketCANInstance* ins,
+                              CanardCANFrame* out_frames,
+                              uint64_t* out_timestamps_usec,
+                              uint16_t max_frames,
+                              int32_t timeout_msec);
+
 /**
  * Returns the file descriptor of the CAN socket.
  * Can be used for external IO multiplexing.
@@ -44,12 +44,13 @@ void _uavcan_equipment_ahrs_MagneticFieldStrength2_encode(uint8_t* buffer, uint3
 
     canardEncodeScalar(buffer, *bit_ofs, 8, &msg->sensor_id);
     *bit_ofs += 8;
-    for (size_t i=0; i < 3; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->magnetic_field_ga[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->magnetic_field_ga)/sizeof(msg->magnetic_field_ga[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->magnetic_field_ga, float16_vals, 3);
+        for (size_t i=0; i < 3; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wtype-limits"
@@ -59,12 +60,13 @@ void _uavcan_equipment_ahrs_MagneticFieldStrength2_encode(uint8_t* buffer, uint3
         canardEncodeScalar(buffer, *bit_ofs, 4, &magnetic_field_covariance_len);
         *bit_ofs += 4;
     }
-    for (size_t i=0; i < magnetic_field_covariance_len; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->magnetic_field_covariance.data[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->magnetic_field_covariance.data)/sizeof(msg->magnetic_field_covariance.data[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->magnetic_field_covariance.data, float16_vals, magnetic_field_covariance_len);
+        for (size_t i=0; i < magnetic_field_covariance_len; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
 }
 
@@ -79,13 +81,13 @@ bool _uavcan_equipment_ahrs_MagneticFieldStrength2_decode(const CanardRxTransfer
     canardDecodeScalar(transfer, *bit_ofs, 8, false, &msg->sensor_id);
     *bit_ofs += 8;
 
-    for (size_t i=0; i < 3; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->magnetic_field_ga[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->magnetic_field_ga)/sizeof(msg->magnetic_field_ga[0])];
+        for (size_t i=0; i < 3; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->magnetic_field_ga, 3);
     }
 
     if (!tao) {
@@ -101,13 +103,13 @@ bool _uavcan_equipment_ahrs_MagneticFieldStrength2_decode(const CanardRxTransfer
         return true; /* invalid value */
     }
 #pragma GCC diagnostic pop
-    for (size_t i=0; i < msg->magnetic_field_covariance.len; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->magnetic_field_covariance.data[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->magnetic_field_covariance.data)/sizeof(msg->magnetic_field_covariance.data[0])];
+        for (size_t i=0; i < msg->magnetic_field_covariance.len; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->magnetic_field_covariance.data, msg->magnetic_field_covariance.len);
     }
 
     return false; /* success */
@@ -50,23 +50,25 @@ void _uavcan_equipment_ahrs_RawIMU_encode(uint8_t* buffer, uint32_t* bit_ofs, st
     _uavcan_Timestamp_encode(buffer, bit_ofs, &msg->timestamp, false);
     canardEncodeScalar(buffer, *bit_ofs, 32, &msg->integration_interval);
     *bit_ofs += 32;
-    for (size_t i=0; i < 3; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->rate_gyro_latest[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->rate_gyro_latest)/sizeof(msg->rate_gyro_latest[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->rate_gyro_latest, float16_vals, 3);
+        for (size_t i=0; i < 3; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
     for (size_t i=0; i < 3; i++) {
         canardEncodeScalar(buffer, *bit_ofs, 32, &msg->rate_gyro_integral[i]);
         *bit_ofs += 32;
     }
-    for (size_t i=0; i < 3; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->accelerometer_latest[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->accelerometer_latest)/sizeof(msg->accelerometer_latest[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->accelerometer_latest, float16_vals, 3);
+        for (size_t i=0; i < 3; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
     for (size_t i=0; i < 3; i++) {
         canardEncodeScalar(buffer, *bit_ofs, 32, &msg->accelerometer_integral[i]);
@@ -80,12 +82,13 @@ void _uavcan_equipment_ahrs_RawIMU_encode(uint8_t* buffer, uint32_t* bit_ofs, st
         canardEncodeScalar(buffer, *bit_ofs, 6, &covariance_len);
         *bit_ofs += 6;
     }
-    for (size_t i=0; i < covariance_len; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->covariance.data[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->covariance.data)/sizeof(msg->covariance.data[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->covariance.data, float16_vals, covariance_len);
+        for (size_t i=0; i < covariance_len; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
 }
 
@@ -102,13 +105,13 @@ bool _uavcan_equipment_ahrs_RawIMU_decode(const CanardRxTransfer* transfer, uint
     canardDecodeScalar(transfer, *bit_ofs, 32, true, &msg->integration_interval);
     *bit_ofs += 32;
 
-    for (size_t i=0; i < 3; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->rate_gyro_latest[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->rate_gyro_latest)/sizeof(msg->rate_gyro_latest[0])];
+        for (size_t i=0; i < 3; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->rate_gyro_latest, 3);
     }
 
     for (size_t i=0; i < 3; i++) {
@@ -116,13 +119,13 @@ bool _uavcan_equipment_ahrs_RawIMU_decode(const CanardRxTransfer* transfer, uint
         *bit_ofs += 32;
     }
 
-    for (size_t i=0; i < 3; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->accelerometer_latest[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->accelerometer_latest)/sizeof(msg->accelerometer_latest[0])];
+        for (size_t i=0; i < 3; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->accelerometer_latest, 3);
     }
 
     for (size_t i=0; i < 3; i++) {
@@ -143,13 +146,13 @@ bool _uavcan_equipment_ahrs_RawIMU_decode(const CanardRxTransfer* transfer, uint
         return true; /* invalid value */
     }
 #pragma GCC diagnostic pop
-    for (size_t i=0; i < msg->covariance.len; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->covariance.data[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->covariance.data)/sizeof(msg->covariance.data[0])];
+        for (size_t i=0; i < msg->covariance.len; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->covariance.data, msg->covariance.len);
     }
 
     return false; /* success */
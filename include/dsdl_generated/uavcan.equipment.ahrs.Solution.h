@@ -48,12 +48,13 @@ void _uavcan_equipment_ahrs_Solution_encode(uint8_t* buffer, uint32_t* bit_ofs,
     (void)tao;
 
     _uavcan_Timestamp_encode(buffer, bit_ofs, &msg->timestamp, false);
-    for (size_t i=0; i < 4; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->orientation_xyzw[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->orientation_xyzw)/sizeof(msg->orientation_xyzw[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->orientation_xyzw, float16_vals, 4);
+        for (size_t i=0; i < 4; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
     *bit_ofs += 4;
 #pragma GCC diagnostic push
@@ -62,19 +63,21 @@ void _uavcan_equipment_ahrs_Solution_encode(uint8_t* buffer, uint32_t* bit_ofs,
 #pragma GCC diagnostic pop
     canardEncodeScalar(buffer, *bit_ofs, 4, &orientation_covariance_len);
     *bit_ofs += 4;
-    for (size_t i=0; i < orientation_covariance_len; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->orientation_covariance.data[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->orientation_covariance.data)/sizeof(msg->orientation_covariance.data[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->orientation_covariance.data, float16_vals, orientation_covariance_len);
+        for (size_t i=0; i < orientation_covariance_len; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
-    for (size_t i=0; i < 3; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->angular_velocity[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->angular_velocity)/sizeof(msg->angular_velocity[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->angular_velocity, float16_vals, 3);
+        for (size_t i=0; i < 3; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
     *bit_ofs += 4;
 #pragma GCC diagnostic push
@@ -83,19 +86,21 @@ void _uavcan_equipment_ahrs_Solution_encode(uint8_t* buffer, uint32_t* bit_ofs,
 #pragma GCC diagnostic pop
     canardEncodeScalar(buffer, *bit_ofs, 4, &angular_velocity_covariance_len);
     *bit_ofs += 4;
-    for (size_t i=0; i < angular_velocity_covariance_len; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->angular_velocity_covariance.data[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->angular_velocity_covariance.data)/sizeof(msg->angular_velocity_covariance.data[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->angular_velocity_covariance.data, float16_vals, angular_velocity_covariance_len);
+        for (size_t i=0; i < angular_velocity_covariance_len; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
-    for (size_t i=0; i < 3; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->linear_acceleration[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->linear_acceleration)/sizeof(msg->linear_acceleration[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->linear_acceleration, float16_vals, 3);
+        for (size_t i=0; i < 3; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wtype-limits"
@@ -105,12 +110,13 @@ void _uavcan_equipment_ahrs_Solution_encode(uint8_t* buffer, uint32_t* bit_ofs,
         canardEncodeScalar(buffer, *bit_ofs, 4, &linear_acceleration_covariance_len);
         *bit_ofs += 4;
     }
-    for (size_t i=0; i < linear_acceleration_covariance_len; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->linear_acceleration_covariance.data[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->linear_acceleration_covariance.data)/sizeof(msg->linear_acceleration_covariance.data[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->linear_acceleration_covariance.data, float16_vals, linear_acceleration_covariance_len);
+        for (size_t i=0; i < linear_acceleration_covariance_len; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
 }
 
@@ -124,13 +130,13 @@ bool _uavcan_equipment_ahrs_Solution_decode(const CanardRxTransfer* transfer, ui
     (void)tao;
     if (_uavcan_Timestamp_decode(transfer, bit_ofs, &msg->timestamp, false)) {return true;}
 
-    for (size_t i=0; i < 4; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->orientation_xyzw[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->orientation_xyzw)/sizeof(msg->orientation_xyzw[0])];
+        for (size_t i=0; i < 4; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->orientation_xyzw, 4);
     }
 
     *bit_ofs += 4;
@@ -143,22 +149,22 @@ bool _uavcan_equipment_ahrs_Solution_decode(const CanardRxTransfer* transfer, ui
         return true; /* invalid value */
     }
 #pragma GCC diagnostic pop
-    for (size_t i=0; i < msg->orientation_covariance.len; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->orientation_covariance.data[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->orientation_covariance.data)/sizeof(msg->orientation_covariance.data[0])];
+        for (size_t i=0; i < msg->orientation_covariance.len; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->orientation_covariance.data, msg->orientation_covariance.len);
     }
 
-    for (size_t i=0; i < 3; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->angular_velocity[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->angular_velocity)/sizeof(msg->angular_velocity[0])];
+        for (size_t i=0; i < 3; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->angular_velocity, 3);
     }
 
     *bit_ofs += 4;
@@ -171,22 +177,22 @@ bool _uavcan_equipment_ahrs_Solution_decode(const CanardRxTransfer* transfer, ui
         return true; /* invalid value */
     }
 #pragma GCC diagnostic pop
-    for (size_t i=0; i < msg->angular_velocity_covariance.len; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->angular_velocity_covariance.data[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->angular_velocity_covariance.data)/sizeof(msg->angular_velocity_covariance.data[0])];
+        for (size_t i=0; i < msg->angular_velocity_covariance.len; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->angular_velocity_covariance.data, msg->angular_velocity_covariance.len);
     }
 
-    for (size_t i=0; i < 3; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->linear_acceleration[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->linear_acceleration)/sizeof(msg->linear_acceleration[0])];
+        for (size_t i=0; i < 3; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->linear_acceleration, 3);
     }
 
     if (!tao) {
@@ -202,13 +208,13 @@ bool _uavcan_equipment_ahrs_Solution_decode(const CanardRxTransfer* transfer, ui
         return true; /* invalid value */
     }
 #pragma GCC diagnostic pop
-    for (size_t i=0; i < msg->linear_acceleration_covariance.len; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->linear_acceleration_covariance.data[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->linear_acceleration_covariance.data)/sizeof(msg->linear_acceleration_covariance.data[0])];
+        for (size_t i=0; i < msg->linear_acceleration_covariance.len; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->linear_acceleration_covariance.data, msg->linear_acceleration_covariance.len);
     }
 
     return false; /* success */
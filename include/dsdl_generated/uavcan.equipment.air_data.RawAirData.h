@@ -86,12 +86,13 @@ void _uavcan_equipment_air_data_RawAirData_encode(uint8_t* buffer, uint32_t* bit
         canardEncodeScalar(buffer, *bit_ofs, 5, &covariance_len);
         *bit_ofs += 5;
     }
-    for (size_t i=0; i < covariance_len; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->covariance.data[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->covariance.data)/sizeof(msg->covariance.data[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->covariance.data, float16_vals, covariance_len);
+        for (size_t i=0; i < covariance_len; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
 }
 
@@ -153,13 +154,13 @@ bool _uavcan_equipment_air_data_RawAirData_decode(const CanardRxTransfer* transf
         return true; /* invalid value */
     }
 #pragma GCC diagnostic pop
-    for (size_t i=0; i < msg->covariance.len; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->covariance.data[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->covariance.data)/sizeof(msg->covariance.data[0])];
+        for (size_t i=0; i < msg->covariance.len; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->covariance.data, msg->covariance.len);
     }
 
     return false; /* success */
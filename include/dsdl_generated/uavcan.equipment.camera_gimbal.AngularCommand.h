@@ -46,12 +46,13 @@ void _uavcan_equipment_camera_gimbal_AngularCommand_encode(uint8_t* buffer, uint
     canardEncodeScalar(buffer, *bit_ofs, 8, &msg->gimbal_id);
     *bit_ofs += 8;
     _uavcan_equipment_camera_gimbal_Mode_encode(buffer, bit_ofs, &msg->mode, false);
-    for (size_t i=0; i < 4; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->quaternion_xyzw[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->quaternion_xyzw)/sizeof(msg->quaternion_xyzw[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->quaternion_xyzw, float16_vals, 4);
+        for (size_t i=0; i < 4; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
 }
 
@@ -68,13 +69,13 @@ bool _uavcan_equipment_camera_gimbal_AngularCommand_decode(const CanardRxTransfe
 
     if (_uavcan_equipment_camera_gimbal_Mode_decode(transfer, bit_ofs, &msg->mode, false)) {return true;}
 
-    for (size_t i=0; i < 4; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->quaternion_xyzw[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->quaternion_xyzw)/sizeof(msg->quaternion_xyzw[0])];
+        for (size_t i=0; i < 4; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->quaternion_xyzw, 4);
     }
 
     return false; /* success */
@@ -47,12 +47,13 @@ void _uavcan_equipment_camera_gimbal_Status_encode(uint8_t* buffer, uint32_t* bi
     canardEncodeScalar(buffer, *bit_ofs, 8, &msg->gimbal_id);
     *bit_ofs += 8;
     _uavcan_equipment_camera_gimbal_Mode_encode(buffer, bit_ofs, &msg->mode, false);
-    for (size_t i=0; i < 4; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->camera_orientation_in_body_frame_xyzw[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->camera_orientation_in_body_frame_xyzw)/sizeof(msg->camera_orientation_in_body_frame_xyzw[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->camera_orientation_in_body_frame_xyzw, float16_vals, 4);
+        for (size_t i=0; i < 4; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wtype-limits"
@@ -62,12 +63,13 @@ void _uavcan_equipment_camera_gimbal_Status_encode(uint8_t* buffer, uint32_t* bi
         canardEncodeScalar(buffer, *bit_ofs, 4, &camera_orientation_in_body_frame_covariance_len);
         *bit_ofs += 4;
     }
-    for (size_t i=0; i < camera_orientation_in_body_frame_covariance_len; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->camera_orientation_in_body_frame_covariance.data[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->camera_orientation_in_body_frame_covariance.data)/sizeof(msg->camera_orientation_in_body_frame_covariance.data[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->camera_orientation_in_body_frame_covariance.data, float16_vals, camera_orientation_in_body_frame_covariance_len);
+        for (size_t i=0; i < camera_orientation_in_body_frame_covariance_len; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
 }
 
@@ -84,13 +86,13 @@ bool _uavcan_equipment_camera_gimbal_Status_decode(const CanardRxTransfer* trans
 
     if (_uavcan_equipment_camera_gimbal_Mode_decode(transfer, bit_ofs, &msg->mode, false)) {return true;}
 
-    for (size_t i=0; i < 4; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->camera_orientation_in_body_frame_xyzw[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->camera_orientation_in_body_frame_xyzw)/sizeof(msg->camera_orientation_in_body_frame_xyzw[0])];
+        for (size_t i=0; i < 4; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->camera_orientation_in_body_frame_xyzw, 4);
     }
 
     if (!tao) {
@@ -106,13 +108,13 @@ bool _uavcan_equipment_camera_gimbal_Status_decode(const CanardRxTransfer* trans
         return true; /* invalid value */
     }
 #pragma GCC diagnostic pop
-    for (size_t i=0; i < msg->camera_orientation_in_body_frame_covariance.len; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->camera_orientation_in_body_frame_covariance.data[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->camera_orientation_in_body_frame_covariance.data)/sizeof(msg->camera_orientation_in_body_frame_covariance.data[0])];
+        for (size_t i=0; i < msg->camera_orientation_in_body_frame_covariance.len; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->camera_orientation_in_body_frame_covariance.data, msg->camera_orientation_in_body_frame_covariance.len);
     }
 
     return false; /* success */
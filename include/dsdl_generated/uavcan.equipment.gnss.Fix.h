@@ -79,12 +79,13 @@ void _uavcan_equipment_gnss_Fix_encode(uint8_t* buffer, uint32_t* bit_ofs, struc
     *bit_ofs += 27;
     canardEncodeScalar(buffer, *bit_ofs, 27, &msg->height_msl_mm);
     *bit_ofs += 27;
-    for (size_t i=0; i < 3; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->ned_velocity[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->ned_velocity)/sizeof(msg->ned_velocity[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->ned_velocity, float16_vals, 3);
+        for (size_t i=0; i < 3; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
     canardEncodeScalar(buffer, *bit_ofs, 6, &msg->sats_used);
     *bit_ofs += 6;
@@ -102,12 +103,13 @@ void _uavcan_equipment_gnss_Fix_encode(uint8_t* buffer, uint32_t* bit_ofs, struc
 #pragma GCC diagnostic pop
     canardEncodeScalar(buffer, *bit_ofs, 4, &position_covariance_len);
     *bit_ofs += 4;
-    for (size_t i=0; i < position_covariance_len; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->position_covariance.data[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->position_covariance.data)/sizeof(msg->position_covariance.data[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->position_covariance.data, float16_vals, position_covariance_len);
+        for (size_t i=0; i < position_covariance_len; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wtype-limits"
@@ -117,12 +119,13 @@ void _uavcan_equipment_gnss_Fix_encode(uint8_t* buffer, uint32_t* bit_ofs, struc
         canardEncodeScalar(buffer, *bit_ofs, 4, &velocity_covariance_len);
         *bit_ofs += 4;
     }
-    for (size_t i=0; i < velocity_covariance_len; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->velocity_covariance.data[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->velocity_covariance.data)/sizeof(msg->velocity_covariance.data[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->velocity_covariance.data, float16_vals, velocity_covariance_len);
+        for (size_t i=0; i < velocity_covariance_len; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
 }
 
@@ -158,13 +161,13 @@ bool _uavcan_equipment_gnss_Fix_decode(const CanardRxTransfer* transfer, uint32_
     canardDecodeScalar(transfer, *bit_ofs, 27, true, &msg->height_msl_mm);
     *bit_ofs += 27;
 
-    for (size_t i=0; i < 3; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->ned_velocity[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->ned_velocity)/sizeof(msg->ned_velocity[0])];
+        for (size_t i=0; i < 3; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->ned_velocity, 3);
     }
 
     canardDecodeScalar(transfer, *bit_ofs, 6, false, &msg->sats_used);
@@ -190,13 +193,13 @@ bool _uavcan_equipment_gnss_Fix_decode(const CanardRxTransfer* transfer, uint32_
         return true; /* invalid value */
     }
 #pragma GCC diagnostic pop
-    for (size_t i=0; i < msg->position_covariance.len; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->position_covariance.data[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->position_covariance.data)/sizeof(msg->position_covariance.data[0])];
+        for (size_t i=0; i < msg->position_covariance.len; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->position_covariance.data, msg->position_covariance.len);
     }
 
     if (!tao) {
@@ -212,13 +215,13 @@ bool _uavcan_equipment_gnss_Fix_decode(const CanardRxTransfer* transfer, uint32_
         return true; /* invalid value */
     }
 #pragma GCC diagnostic pop
-    for (size_t i=0; i < msg->velocity_covariance.len; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->velocity_covariance.data[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->velocity_covariance.data)/sizeof(msg->velocity_covariance.data[0])];
+        for (size_t i=0; i < msg->velocity_covariance.len; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->velocity_covariance.data, msg->velocity_covariance.len);
     }
 
     return false; /* success */
@@ -108,12 +108,13 @@ void _uavcan_equipment_gnss_Fix2_encode(uint8_t* buffer, uint32_t* bit_ofs, stru
 #pragma GCC diagnostic pop
     canardEncodeScalar(buffer, *bit_ofs, 6, &covariance_len);
     *bit_ofs += 6;
-    for (size_t i=0; i < covariance_len; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->covariance.data[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->covariance.data)/sizeof(msg->covariance.data[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->covariance.data, float16_vals, covariance_len);
+        for (size_t i=0; i < covariance_len; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
     {
         uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->pdop);
@@ -190,13 +191,13 @@ bool _uavcan_equipment_gnss_Fix2_decode(const CanardRxTransfer* transfer, uint32
         return true; /* invalid value */
     }
 #pragma GCC diagnostic pop
-    for (size_t i=0; i < msg->covariance.len; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->covariance.data[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->covariance.data)/sizeof(msg->covariance.data[0])];
+        for (size_t i=0; i < msg->covariance.len; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->covariance.data, msg->covariance.len);
     }
 
     {
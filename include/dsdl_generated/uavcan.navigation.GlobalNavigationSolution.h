@@ -82,12 +82,13 @@ void _uavcan_navigation_GlobalNavigationSolution_encode(uint8_t* buffer, uint32_
 #pragma GCC diagnostic pop
     canardEncodeScalar(buffer, *bit_ofs, 6, &pose_covariance_len);
     *bit_ofs += 6;
-    for (size_t i=0; i < pose_covariance_len; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->pose_covariance.data[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->pose_covariance.data)/sizeof(msg->pose_covariance.data[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->pose_covariance.data, float16_vals, pose_covariance_len);
+        for (size_t i=0; i < pose_covariance_len; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
     for (size_t i=0; i < 3; i++) {
         canardEncodeScalar(buffer, *bit_ofs, 32, &msg->linear_velocity_body[i]);
@@ -97,12 +98,13 @@ void _uavcan_navigation_GlobalNavigationSolution_encode(uint8_t* buffer, uint32_
         canardEncodeScalar(buffer, *bit_ofs, 32, &msg->angular_velocity_body[i]);
         *bit_ofs += 32;
     }
-    for (size_t i=0; i < 3; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->linear_acceleration_body[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->linear_acceleration_body)/sizeof(msg->linear_acceleration_body[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->linear_acceleration_body, float16_vals, 3);
+        for (size_t i=0; i < 3; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wtype-limits"
@@ -112,12 +114,13 @@ void _uavcan_navigation_GlobalNavigationSolution_encode(uint8_t* buffer, uint32_
         canardEncodeScalar(buffer, *bit_ofs, 6, &velocity_covariance_len);
         *bit_ofs += 6;
     }
-    for (size_t i=0; i < velocity_covariance_len; i++) {
-        {
-            uint16_t float16_val = canardConvertNativeFloatToFloat16(msg->velocity_covariance.data[i]);
-            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->velocity_covariance.data)/sizeof(msg->velocity_covariance.data[0])];
+        canardConvertNativeFloatArrayToFloat16(msg->velocity_covariance.data, float16_vals, velocity_covariance_len);
+        for (size_t i=0; i < velocity_covariance_len; i++) {
+            canardEncodeScalar(buffer, *bit_ofs, 16, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
     }
 }
 
@@ -169,13 +172,13 @@ bool _uavcan_navigation_GlobalNavigationSolution_decode(const CanardRxTransfer*
         return true; /* invalid value */
     }
 #pragma GCC diagnostic pop
-    for (size_t i=0; i < msg->pose_covariance.len; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->pose_covariance.data[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->pose_covariance.data)/sizeof(msg->pose_covariance.data[0])];
+        for (size_t i=0; i < msg->pose_covariance.len; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->pose_covariance.data, msg->pose_covariance.len);
     }
 
     for (size_t i=0; i < 3; i++) {
@@ -188,13 +191,13 @@ bool _uavcan_navigation_GlobalNavigationSolution_decode(const CanardRxTransfer*
         *bit_ofs += 32;
     }
 
-    for (size_t i=0; i < 3; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->linear_acceleration_body[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->linear_acceleration_body)/sizeof(msg->linear_acceleration_body[0])];
+        for (size_t i=0; i < 3; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->linear_acceleration_body, 3);
     }
 
     if (!tao) {
@@ -210,13 +213,13 @@ bool _uavcan_navigation_GlobalNavigationSolution_decode(const CanardRxTransfer*
         return true; /* invalid value */
     }
 #pragma GCC diagnostic pop
-    for (size_t i=0; i < msg->velocity_covariance.len; i++) {
-        {
-            uint16_t float16_val;
-            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_val);
-            msg->velocity_covariance.data[i] = canardConvertFloat16ToNativeFloat(float16_val);
+    {
+        uint16_t float16_vals[sizeof(msg->velocity_covariance.data)/sizeof(msg->velocity_covariance.data[0])];
+        for (size_t i=0; i < msg->velocity_covariance.len; i++) {
+            canardDecodeScalar(transfer, *bit_ofs, 16, true, &float16_vals[i]);
+            *bit_ofs += 16;
         }
-        *bit_ofs += 16;
+        canardConvertFloat16ArrayToNativeFloat(float16_vals, msg->velocity_covariance.data, msg->velocity_covariance.len);
     }
 
     return false; /* success */
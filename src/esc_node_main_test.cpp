@@ -3,15 +3,55 @@
 
 int main(int argc, char** argv)
 {
-    if (argc < 2) {
+    DroneCanNode node;
+
+    // Leading options: --canfd switches all buses to CAN FD, --io-thread[=<cpu>] services the sockets from a
+    // dedicated thread, optionally pinned to a CPU, --rx-pool=<blocks> and --tx-pool=<blocks> size the memory pools
+    // and --hugepages backs them with huge pages
+    bool canfd = false;
+    CanardInterface::PoolConfig pools;
+    int first_iface = 1;
+    for (; first_iface < argc && strncmp(argv[first_iface], "--", 2) == 0; first_iface++) {
+        if (strcmp(argv[first_iface], "--canfd") == 0) {
+            canfd = true;
+        } else if (strcmp(argv[first_iface], "--io-thread") == 0) {
+            node.enable_io_thread();
+        } else if (strncmp(argv[first_iface], "--io-thread=", 12) == 0) {
+            node.enable_io_thread(atoi(argv[first_iface] + 12));
+        } else if (strncmp(argv[first_iface], "--rx-pool=", 10) == 0) {
+            pools.rx_blocks = uint32_t(strtoul(argv[first_iface] + 10, nullptr, 0));
+        } else if (strncmp(argv[first_iface], "--tx-pool=", 10) == 0) {
+            pools.tx_blocks = uint32_t(strtoul(argv[first_iface] + 10, nullptr, 0));
+        } else if (strcmp(argv[first_iface], "--hugepages") == 0) {
+            pools.hugepages = true;
+        } else {
+            (void)fprintf(stderr, "Unknown option %s\n", argv[first_iface]);
+            return 1;
+        }
+    }
+
+    if (argc <= first_iface) {
         (void)fprintf(stderr,
                       "Usage:\n"
-                      "\t%s <can iface name>\n",
+                      "\t%s [--canfd] [--io-thread[=<cpu>]] [--rx-pool=<blocks>] [--tx-pool=<blocks>] [--hugepages]\n"
+                      "\t\t<can iface name> [<redundant can iface name> ...]\n",
                       argv[0]);
         return 1;
     }
 
-    DroneCanNode node;
-    node.start_node(argv[1]);
+    if (argc - first_iface > CANARD_INTERFACE_MAX_IFACES) {
+        (void)fprintf(stderr, "At most %d CAN interfaces are supported\n", CANARD_INTERFACE_MAX_IFACES);
+        return 1;
+    }
+
+#if !CANARD_ENABLE_CANFD
+    if (canfd) {
+        (void)fprintf(stderr, "CAN FD support is not enabled in this build\n");
+        return 1;
+    }
+#endif
+
+    node.set_pool_config(pools);
+    node.start_node(&argv[first_iface], uint8_t(argc - first_iface), canfd);
     return 0;
-}
\ No newline at end of file
+}